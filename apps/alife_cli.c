@@ -0,0 +1,1263 @@
+// Headless command-line frontend: benchmark suite, headless runs and soak runs on libalife
+#define _GNU_SOURCE // For sysconf page size
+#include <stdio.h>    // For input/output operations (printf)
+#include <stdlib.h>   // For dynamic memory allocation (malloc, free)
+#include <string.h>   // For parsing command-line options (strcmp)
+#include <time.h>     // For nanosleep
+#include <unistd.h>   // For sysconf (page size)
+#include <pthread.h>  // For the branch threads
+
+#include "alife.h"
+#include "app_options.h"
+#include "control_socket.h"
+#include "genetic.h"
+
+// --- Benchmark Parameters ---
+#define BENCH_DEFAULT_RUNS 5   // Timed repetitions per scenario
+#define BENCH_DEFAULT_WARMUP 1 // Untimed repetitions run first to warm caches and the allocator
+#define BENCH_DEFAULT_SEED 12345
+#define BENCH_DEFAULT_REPLAY_STEPS 500 // Steps replayed from a captured workload per timed run
+
+// --- Validation Parameters ---
+#define VALIDATE_DEFAULT_TOLERANCE 1e-9 // Relative tolerance of --validate tolerance
+
+// --- Run Parameters ---
+#define RUN_CHECK_INTERVAL 100       // Steps between checks of the stopping criteria
+#define STEADY_DEFAULT_TOLERANCE 0.05 // Population range of --stop-steady, relative to its maximum
+#define RUN_CONTROL_INTERVAL 10       // Steps between polls of the control socket (--control)
+#define RUN_PAUSED_POLL_NS 10000000   // Interval of control socket polls while paused
+
+// --- Island Parameters ---
+#define ISLANDS_DEFAULT_STEPS 10000 // Steps of an island run
+
+// --- Branch Parameters ---
+#define BRANCH_DEFAULT_STEPS 1000 // Steps before forking and steps of every branch
+#define BRANCH_MAX 64             // Branches of one run, including the unchanged one
+
+// --- Soak Parameters ---
+#define SOAK_DEFAULT_STEPS 1000000000LL   // Steps of a soak run
+#define SOAK_DEFAULT_INTERVAL 100000      // Steps per sample
+#define SOAK_DEFAULT_WARMUP_SAMPLES 3     // Samples before the memory and step-time baselines are taken
+#define SOAK_DEFAULT_MAX_RSS_GROWTH_MB 16.0 // Resident memory growth over the baseline that fails the soak
+#define SOAK_DEFAULT_MAX_DRIFT 0.25       // Relative step-time increase at constant population that fails...
+#define SOAK_DRIFT_SAMPLES 3              // ...once it persists for this many consecutive samples
+#define SOAK_BUCKETS 16                   // Population and food buckets of the step-time baselines
+
+// A fixed, seeded workload used by the benchmark mode
+typedef struct {
+    const char* name;
+    int initial_life_forms;
+    int initial_food_sources;
+    int max_life_forms;      // Capacity of the life form array for this scenario
+    int max_food_sources;    // Capacity of the food array for this scenario
+    int steps;               // Steps per timed run
+} BenchScenario;
+
+// Benchmark suite: small default world, a world kept at capacity, and a large world
+// where the O(life forms * food) nearest-food search dominates
+const BenchScenario bench_scenarios[] = {
+    { "default", INITIAL_LIFE_FORMS, INITIAL_FOOD_SOURCES, MAX_LIFE_FORMS, MAX_FOOD_SOURCES, 2000 },
+    { "crowded", MAX_LIFE_FORMS, MAX_FOOD_SOURCES, MAX_LIFE_FORMS, MAX_FOOD_SOURCES, 1000 },
+    { "large", 2000, 1000, 4000, 2000, 200 },
+};
+const int bench_scenario_count = sizeof(bench_scenarios) / sizeof(bench_scenarios[0]);
+
+// What the run observers collect during a headless run
+typedef struct {
+    long long steps;           // Steps observed
+    long long births;
+    long long deaths;
+    long long feeds;
+    int peak_population;
+    double population_sum;     // Over the observed steps, for the mean
+    long long extinct_step;    // Step count at which the last life form died, or -1
+    int* window;               // Population of the last window_size steps (ring buffer), for --stop-steady
+    int window_size;
+    long long window_filled;
+    FILE* event_log;           // --event-log, or NULL
+} RunStats;
+
+// --- Function Prototypes ---
+
+// Benchmark mode
+const BenchScenario* find_bench_scenario(const char* name);
+void scenario_config(const BenchScenario* scenario, unsigned long long seed, WorldConfig* config);
+int run_benchmark(const BenchScenario* scenario, const char* workload, unsigned long long seed,
+                  int runs, int warmup, int steps);
+int bench_main(int argc, char* args[]);
+
+// Headless runs
+void observe_births(void* user, const BirthEvent* events, int count);
+void observe_deaths(void* user, const DeathEvent* events, int count);
+void observe_feeding(void* user, const FeedEvent* events, int count);
+void observe_steps(void* user, const StepEvent* event);
+int population_steady(const RunStats* stats, double tolerance);
+int start_run_observers(World* world, RunStats* stats);
+void print_run_json(const World* world, const char* scenario, const char* stop, const RunStats* stats);
+World* prepare_world(const BenchScenario* scenario, const char* resume_path, unsigned long long seed);
+int run_main(int argc, char* args[]);
+
+// Soak mode
+long long read_rss_bytes();
+int soak_main(int argc, char* args[]);
+
+// Island mode
+double mean_speed_factor(const World* world);
+void print_islands(Archipelago* archipelago);
+int islands_main(int argc, char* args[]);
+
+// GA mode
+int ga_main(int argc, char* args[]);
+
+// Branch mode
+void* run_branch(void* arg);
+int branches_main(int argc, char* args[]);
+
+int start_profiler();
+void stop_profiler(FILE* out);
+void print_usage(const char* program);
+
+// --- Main Function ---
+int main(int argc, char* args[]) {
+    if (argc > 1 && strcmp(args[1], "--bench") == 0) {
+        return bench_main(argc - 1, args + 1);
+    }
+    if (argc > 1 && strcmp(args[1], "--run") == 0) {
+        return run_main(argc - 1, args + 1);
+    }
+    if (argc > 1 && strcmp(args[1], "--soak") == 0) {
+        return soak_main(argc - 1, args + 1);
+    }
+    if (argc > 1 && strcmp(args[1], "--islands") == 0) {
+        return islands_main(argc - 1, args + 1);
+    }
+    if (argc > 1 && strcmp(args[1], "--ga") == 0) {
+        return ga_main(argc - 1, args + 1);
+    }
+    if (argc > 1 && strcmp(args[1], "--branches") == 0) {
+        return branches_main(argc - 1, args + 1);
+    }
+    print_usage(args[0]);
+    return argc > 1 && strcmp(args[1], "--help") == 0 ? 0 : 1;
+}
+
+// Starts the profiler if --profile was given; returns 0 on failure
+int start_profiler() {
+#ifdef ALIFE_PROFILER
+    if (profiler_enabled) {
+        return alife_profiler_start(profiler_hz);
+    }
+#endif
+    return 1;
+}
+
+// Stops the profiler, if it was started, and prints its report
+void stop_profiler(FILE* out) {
+#ifdef ALIFE_PROFILER
+    if (profiler_enabled) {
+        alife_profiler_stop();
+        alife_profiler_report(out);
+    }
+#else
+    (void)out;
+#endif
+}
+
+// --- Benchmark Mode ---
+
+// Looks up a benchmark scenario by name; returns NULL if there is none
+const BenchScenario* find_bench_scenario(const char* name) {
+    for (int i = 0; i < bench_scenario_count; ++i) {
+        if (strcmp(bench_scenarios[i].name, name) == 0) {
+            return &bench_scenarios[i];
+        }
+    }
+    return NULL;
+}
+
+// Fills config with the scenario's initial world and the threading options
+void scenario_config(const BenchScenario* scenario, unsigned long long seed, WorldConfig* config) {
+    world_default_config(config);
+    config->max_life_forms = scenario->max_life_forms;
+    config->max_food_sources = scenario->max_food_sources;
+    config->initial_life_forms = scenario->initial_life_forms;
+    config->initial_food_sources = scenario->initial_food_sources;
+    config->seed = seed;
+    apply_common_options(config);
+}
+
+// Runs one scenario `warmup + runs` times from the same seed, or replays a captured workload
+// (checkpoint file) that many times, and prints one JSON line holding the per-run samples
+// (mean nanoseconds per step, total and per phase). Exactly one of scenario and workload is set.
+// Statistics are left to the consumer (tools/perf_gate.py). Returns 0 on failure.
+int run_benchmark(const BenchScenario* scenario, const char* workload, unsigned long long seed,
+                  int runs, int warmup, int steps) {
+    double* samples = (double*)malloc((size_t)runs * (PHASE_COUNT + 1) * sizeof(double));
+    int* final_population = (int*)malloc((size_t)runs * sizeof(int));
+#ifdef ALIFE_TRACK_ALLOCS
+    long long step_allocs = 0; // Allocations made inside steps over all timed runs
+    long long step_bytes = 0;
+#endif
+    if (samples == NULL || final_population == NULL) {
+        fprintf(stderr, "Memory allocation failed for benchmark samples!\n");
+        free(samples);
+        free(final_population);
+        return 0;
+    }
+
+    // Workloads are reported by file name without directory and extension
+    char name[128];
+    WorldConfig config;
+    if (workload != NULL) {
+        const char* base = strrchr(workload, '/') != NULL ? strrchr(workload, '/') + 1 : workload;
+        snprintf(name, sizeof(name), "workload:%.*s", (int)strcspn(base, "."), base);
+        world_default_config(&config);
+        apply_common_options(&config);
+    } else {
+        snprintf(name, sizeof(name), "%s", scenario->name);
+        scenario_config(scenario, seed, &config);
+    }
+
+    unsigned long long run_seed = seed;
+    const char* kernel_name = "generic";
+    int initial_population = 0;
+    double area = 0.0;
+    for (int run = -warmup; run < runs; ++run) {
+        // Every run replays exactly the same workload
+        World* world = workload != NULL ? world_load_checkpoint(workload, &config) : world_create(&config);
+        if (world == NULL) {
+            free(samples);
+            free(final_population);
+            return 0;
+        }
+        run_seed = world_seed(world);
+        kernel_name = world_kernel_name(world); // Static strings, still valid after world_destroy
+        initial_population = world_life_form_count(world);
+        area = world_params(world)->width * world_params(world)->height;
+#ifdef ALIFE_TRACK_ALLOCS
+        alife_alloc_reset_stats();
+#endif
+
+        double start = alife_now_ns();
+        world_step_n(world, steps);
+        double elapsed = alife_now_ns() - start;
+
+        if (run >= 0) {
+            double* row = &samples[run * (PHASE_COUNT + 1)];
+            const double* phase_time_ns = world_phase_times_ns(world);
+            row[0] = elapsed / steps;
+            for (int p = 0; p < PHASE_COUNT; ++p) {
+                row[p + 1] = phase_time_ns[p] / steps;
+            }
+            final_population[run] = world_life_form_count(world);
+#ifdef ALIFE_TRACK_ALLOCS
+            for (int p = 0; p < PHASE_COUNT; ++p) {
+                AllocStats stats = alife_alloc_phase_stats(p);
+                step_allocs += stats.allocs;
+                step_bytes += stats.bytes_allocated;
+            }
+#endif
+        }
+        world_destroy(world);
+    }
+
+    printf("{\"scenario\": \"%s\", \"seed\": %llu, \"steps\": %d, \"runs\": %d, \"threads\": %d, \"pin\": \"%s\", "
+           "\"kernels\": \"%s\", \"engine\": \"%s\", \"metrics\": {", name, run_seed, steps, runs, thread_count,
+           pin_strategy_name(pin_strategy), kernel_name, engine_name(engine_kind));
+    for (int m = 0; m <= PHASE_COUNT; ++m) {
+        printf("%s\"%s_ns\": [", m == 0 ? "" : ", ", m == 0 ? "step" : world_phase_name(m - 1));
+        for (int run = 0; run < runs; ++run) {
+            printf("%s%.1f", run == 0 ? "" : ", ", samples[run * (PHASE_COUNT + 1) + m]);
+        }
+        printf("]");
+    }
+    printf("}, \"initial_population\": %d, \"area\": %.0f, \"final_population\": [", initial_population, area);
+    for (int run = 0; run < runs; ++run) {
+        printf("%s%d", run == 0 ? "" : ", ", final_population[run]);
+    }
+    printf("]");
+#ifdef ALIFE_TRACK_ALLOCS
+    printf(", \"allocations\": {\"per_step\": %.3f, \"bytes_per_step\": %.1f}",
+           (double)step_allocs / ((double)runs * steps), (double)step_bytes / ((double)runs * steps));
+#endif
+    printf("}\n");
+    fflush(stdout);
+
+    free(samples);
+    free(final_population);
+    return 1;
+}
+
+// Parses the benchmark options (args[0] is "--bench") and runs the selected scenarios
+int bench_main(int argc, char* args[]) {
+    const char* scenario_name = "all";
+    const char* workload = NULL;
+    unsigned long long seed = BENCH_DEFAULT_SEED;
+    int runs = BENCH_DEFAULT_RUNS;
+    int warmup = BENCH_DEFAULT_WARMUP;
+    int steps = 0; // 0 = scenario default
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(args[i], "--list") == 0) {
+            for (int s = 0; s < bench_scenario_count; ++s) {
+                printf("%s\n", bench_scenarios[s].name);
+            }
+            return 0;
+        } else if (i + 1 < argc && strcmp(args[i], "--scenario") == 0) {
+            scenario_name = args[++i];
+        } else if (i + 1 < argc && strcmp(args[i], "--workload") == 0) {
+            workload = args[++i];
+        } else if (i + 1 < argc && strcmp(args[i], "--seed") == 0) {
+            seed = strtoull(args[++i], NULL, 10);
+        } else if (i + 1 < argc && strcmp(args[i], "--runs") == 0) {
+            runs = atoi(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--warmup") == 0) {
+            warmup = atoi(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--steps") == 0) {
+            steps = atoi(args[++i]);
+        } else if (parse_common_option(argc, args, &i)) {
+            // Threading, world and profiler options
+        } else if (strcmp(args[i], "--assert-no-alloc") == 0) {
+#ifdef ALIFE_TRACK_ALLOCS
+            alife_alloc_set_assert_steady_state(1);
+#else
+            fprintf(stderr, "--assert-no-alloc needs a build with ALIFE_TRACK_ALLOCS\n");
+            return 2;
+#endif
+        } else {
+            fprintf(stderr, "Unknown benchmark option: %s\n", args[i]);
+            return 2;
+        }
+    }
+    if (runs < 1 || warmup < 0 || steps < 0) {
+        fprintf(stderr, "--runs must be at least 1; --warmup and --steps must not be negative\n");
+        return 2;
+    }
+    if (!check_common_options()) {
+        return 2;
+    }
+    if (strcmp(scenario_name, "all") != 0 && find_bench_scenario(scenario_name) == NULL) {
+        fprintf(stderr, "Unknown benchmark scenario: %s (use --bench --list)\n", scenario_name);
+        return 2;
+    }
+    if (!start_profiler()) {
+        return 1;
+    }
+
+    int ok = 1;
+    if (workload != NULL) {
+        ok = run_benchmark(NULL, workload, 0, runs, warmup, steps > 0 ? steps : BENCH_DEFAULT_REPLAY_STEPS);
+    }
+    for (int s = 0; s < bench_scenario_count && ok && workload == NULL; ++s) {
+        const BenchScenario* scenario = &bench_scenarios[s];
+        if (strcmp(scenario_name, "all") != 0 && strcmp(scenario_name, scenario->name) != 0) {
+            continue;
+        }
+        ok = run_benchmark(scenario, NULL, seed, runs, warmup, steps > 0 ? steps : scenario->steps);
+    }
+    stop_profiler(stderr); // stdout carries the JSON results
+    return ok ? 0 : 1;
+}
+
+// --- Run Observers ---
+// Headless runs watch the world through the observer hooks for their statistics (--json), the
+// stopping criteria (--stop-extinct, --stop-steady) and the event log (--event-log), which has one
+// CSV row per birth, death and feeding:
+// step,event,life_form,parent,x,y,energy (parent is only set for births; x,y is the food for feeding)
+
+void observe_births(void* user, const BirthEvent* events, int count) {
+    RunStats* stats = (RunStats*)user;
+    stats->births += count;
+    for (int i = 0; i < count && stats->event_log != NULL; ++i) {
+        const LifeForm* child = &events[i].child;
+        fprintf(stats->event_log, "%lld,birth,%d,%d,%.3f,%.3f,%.3f\n", events[i].step, child->id,
+                events[i].parent_id, child->x, child->y, child->energy);
+    }
+}
+
+void observe_deaths(void* user, const DeathEvent* events, int count) {
+    RunStats* stats = (RunStats*)user;
+    stats->deaths += count;
+    for (int i = 0; i < count && stats->event_log != NULL; ++i) {
+        const LifeForm* lf = &events[i].life_form;
+        fprintf(stats->event_log, "%lld,death,%d,,%.3f,%.3f,%.3f\n", events[i].step, lf->id, lf->x, lf->y,
+                lf->energy);
+    }
+}
+
+void observe_feeding(void* user, const FeedEvent* events, int count) {
+    RunStats* stats = (RunStats*)user;
+    stats->feeds += count;
+    for (int i = 0; i < count && stats->event_log != NULL; ++i) {
+        fprintf(stats->event_log, "%lld,feed,%d,,%.3f,%.3f,%.3f\n", events[i].step, events[i].life_form_id,
+                events[i].food_x, events[i].food_y, events[i].energy);
+    }
+}
+
+void observe_steps(void* user, const StepEvent* event) {
+    RunStats* stats = (RunStats*)user;
+    stats->steps++;
+    stats->population_sum += event->life_forms;
+    if (event->life_forms > stats->peak_population) {
+        stats->peak_population = event->life_forms;
+    }
+    if (event->life_forms == 0 && stats->extinct_step < 0) {
+        stats->extinct_step = event->step + 1;
+    }
+    if (stats->window != NULL) {
+        stats->window[stats->window_filled++ % stats->window_size] = event->life_forms;
+    }
+}
+
+// Returns 1 once the population of the last window_size steps stayed within tolerance of its maximum
+int population_steady(const RunStats* stats, double tolerance) {
+    if (stats->window == NULL || stats->window_filled < stats->window_size) {
+        return 0;
+    }
+    int low = stats->window[0];
+    int high = stats->window[0];
+    for (int i = 1; i < stats->window_size; ++i) {
+        if (stats->window[i] < low) low = stats->window[i];
+        if (stats->window[i] > high) high = stats->window[i];
+    }
+    return high > 0 && high - low <= tolerance * high;
+}
+
+// Registers the run observers on world; returns 0 if the build lacks one of their categories
+int start_run_observers(World* world, RunStats* stats) {
+    if (stats->event_log != NULL) {
+        fprintf(stats->event_log, "step,event,life_form,parent,x,y,energy\n");
+    }
+    return world_observe_births(world, observe_births, stats) && world_observe_deaths(world, observe_deaths, stats)
+           && world_observe_feeding(world, observe_feeding, stats) && world_observe_steps(world, observe_steps, stats);
+}
+
+// Prints the run's summary as one JSON line
+void print_run_json(const World* world, const char* scenario, const char* stop, const RunStats* stats) {
+    printf("{\"scenario\": \"%s\", \"seed\": %llu, \"steps\": %lld, \"stop\": \"%s\", "
+           "\"final_population\": %d, \"final_food\": %d, \"peak_population\": %d, \"mean_population\": %.3f, "
+           "\"births\": %lld, \"deaths\": %lld, \"feeds\": %lld, \"extinct_step\": %lld, "
+           "\"food_model\": \"%s\", \"field_total\": %.6f}\n",
+           scenario, world_seed(world), stats->steps, stop, world_life_form_count(world), world_food_count(world),
+           stats->peak_population, stats->steps > 0 ? stats->population_sum / stats->steps : 0.0,
+           stats->births, stats->deaths, stats->feeds, stats->extinct_step, food_model_name(world_food_model(world)),
+           world_field_total(world));
+}
+
+// --- Headless Runs ---
+
+// Creates the world for a headless run: from the checkpoint at resume_path if there is one, with the
+// world options given overriding its parameters, otherwise the scenario's initial world; tuned with
+// --autotune. Returns NULL on failure.
+World* prepare_world(const BenchScenario* scenario, const char* resume_path, unsigned long long seed) {
+    WorldConfig config;
+    scenario_config(scenario, seed, &config);
+    World* world = resume_path != NULL ? world_load_checkpoint(resume_path, &config) : world_create(&config);
+    if (world != NULL && resume_path != NULL && !apply_param_options(world)) {
+        world_destroy(world);
+        return NULL;
+    }
+    if (world != NULL && autotune_enabled && !autotune_world(world, tuning_cache_path, autotune_threads)) {
+        world_destroy(world);
+        return NULL;
+    }
+    return world;
+}
+
+// Parses the run options (args[0] is "--run"), runs the simulation headless and optionally
+// captures a checkpoint of the state after a given step, e.g. to add to the benchmark workloads.
+// A run can stop early once its population is extinct or steady, e.g. in a parameter sweep.
+int run_main(int argc, char* args[]) {
+    const char* scenario_name = "default";
+    const char* resume_path = NULL;
+    const char* capture_path = "capture.alck";
+    const char* event_log_path = NULL;
+    const char* control_path = NULL;
+    unsigned long long seed = BENCH_DEFAULT_SEED;
+    long long steps = 1000;
+    long long capture_at = -1;
+    long long hash_every = 0;
+    ValidationMode validation_mode = VALIDATE_OFF;
+    double validation_tolerance = VALIDATE_DEFAULT_TOLERANCE;
+    int json = 0;
+    int stop_extinct = 0;
+    int stop_steady = 0; // Window in steps; 0 = off
+    double steady_tolerance = STEADY_DEFAULT_TOLERANCE;
+
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 < argc && strcmp(args[i], "--scenario") == 0) {
+            scenario_name = args[++i];
+        } else if (strcmp(args[i], "--json") == 0) {
+            json = 1;
+        } else if (strcmp(args[i], "--stop-extinct") == 0) {
+            stop_extinct = 1;
+        } else if (i + 1 < argc && strcmp(args[i], "--stop-steady") == 0) {
+            stop_steady = atoi(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--steady-tolerance") == 0) {
+            steady_tolerance = atof(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--resume") == 0) {
+            resume_path = args[++i];
+        } else if (i + 1 < argc && strcmp(args[i], "--seed") == 0) {
+            seed = strtoull(args[++i], NULL, 10);
+        } else if (i + 1 < argc && strcmp(args[i], "--steps") == 0) {
+            steps = atoll(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--capture-at") == 0) {
+            capture_at = atoll(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--capture-out") == 0) {
+            capture_path = args[++i];
+        } else if (i + 1 < argc && strcmp(args[i], "--hash-every") == 0) {
+            hash_every = atoll(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--event-log") == 0) {
+            event_log_path = args[++i];
+        } else if (i + 1 < argc && strcmp(args[i], "--control") == 0) {
+            control_path = args[++i];
+        } else if (i + 1 < argc && strcmp(args[i], "--validate") == 0) {
+            ++i;
+            if (strcmp(args[i], "exact") == 0) {
+                validation_mode = VALIDATE_EXACT;
+            } else if (strcmp(args[i], "tolerance") == 0) {
+                validation_mode = VALIDATE_TOLERANCE;
+            } else {
+                fprintf(stderr, "Unknown validation mode: %s (use exact or tolerance)\n", args[i]);
+                return 2;
+            }
+        } else if (i + 1 < argc && strcmp(args[i], "--tolerance") == 0) {
+            validation_tolerance = atof(args[++i]);
+        } else if (parse_common_option(argc, args, &i)) {
+            // Threading, world and profiler options
+        } else {
+            fprintf(stderr, "Unknown run option: %s\n", args[i]);
+            return 2;
+        }
+    }
+    const BenchScenario* scenario = find_bench_scenario(scenario_name);
+    if (scenario == NULL) {
+        fprintf(stderr, "Unknown scenario: %s (use --bench --list)\n", scenario_name);
+        return 2;
+    }
+    if (steps < 0 || hash_every < 0 || validation_tolerance < 0 || stop_steady < 0 || steady_tolerance < 0
+        || !check_common_options()) {
+        return 2;
+    }
+
+    World* world = prepare_world(scenario, resume_path, seed);
+    if (world == NULL) {
+        return 1;
+    }
+    RunStats stats;
+    memset(&stats, 0, sizeof(stats));
+    stats.extinct_step = world_life_form_count(world) == 0 ? world_step_count(world) : -1;
+    stats.window_size = stop_steady;
+    int ok = 1;
+    if (event_log_path != NULL) {
+        stats.event_log = fopen(event_log_path, "w");
+        if (stats.event_log == NULL) {
+            fprintf(stderr, "Could not open event log %s\n", event_log_path);
+            ok = 0;
+        }
+    }
+    if (stop_steady > 0) {
+        stats.window = (int*)malloc(stop_steady * sizeof(int));
+        ok = ok && stats.window != NULL;
+    }
+    int observed = json || stop_extinct || stop_steady > 0 || stats.event_log != NULL;
+    ControlServer control;
+    control.listen_fd = -1;
+    ok = ok && world_set_validation(world, validation_mode, validation_tolerance)
+         && (!observed || start_run_observers(world, &stats))
+         && (control_path == NULL || control_start(&control, control_path, world)) && start_profiler();
+    if (!ok) {
+        control_stop(&control);
+        world_destroy(world);
+        free(stats.window);
+        if (stats.event_log != NULL) fclose(stats.event_log);
+        return 1;
+    }
+
+    // Steps run in batches up to the next step that is hashed or captured, and with a stopping
+    // criterion, at most RUN_CHECK_INTERVAL steps at a time. With a control socket, commands are
+    // executed between batches of at most RUN_CONTROL_INTERVAL steps.
+    const char* stop = "steps";
+    long long start_step = world_step_count(world);
+    long long end_step = start_step + steps;
+    while (world_step_count(world) < end_step && ok) {
+        if (control_path != NULL) {
+            control_poll(&control, world);
+            const struct timespec idle = { 0, RUN_PAUSED_POLL_NS };
+            while (control.paused && !control.stop_requested) {
+                nanosleep(&idle, NULL);
+                control_publish(&control, world);
+                control_poll(&control, world);
+            }
+            if (control.stop_requested) {
+                stop = "control";
+                break;
+            }
+        }
+        long long step = world_step_count(world);
+        long long batch_end = end_step;
+        if ((stop_extinct || stop_steady > 0) && step + RUN_CHECK_INTERVAL < batch_end) {
+            batch_end = step + RUN_CHECK_INTERVAL;
+        }
+        if (control_path != NULL && step + RUN_CONTROL_INTERVAL < batch_end) {
+            batch_end = step + RUN_CONTROL_INTERVAL;
+        }
+        if (hash_every > 0 && step + hash_every - (step - start_step) % hash_every < batch_end) {
+            batch_end = step + hash_every - (step - start_step) % hash_every;
+        }
+        if (capture_at > step && capture_at < batch_end) {
+            batch_end = capture_at;
+        }
+        if (world_step_n(world, batch_end - step) < batch_end - step) {
+            ok = 0; // Validation mismatch, already reported
+            break;
+        }
+        step = world_step_count(world);
+        if (control_path != NULL) {
+            control_publish(&control, world);
+        }
+        if (hash_every > 0 && ((step - start_step) % hash_every == 0 || step == end_step)) {
+            printf("hash %lld %016llx\n", step, world_state_hash(world));
+        }
+        if (step == capture_at) {
+            ok = world_save_checkpoint(world, capture_path);
+            if (ok) {
+                printf("Captured step %lld (seed %llu) to %s\n", step, world_seed(world), capture_path);
+            }
+        }
+        if (stop_extinct && world_life_form_count(world) == 0) {
+            stop = "extinct";
+            break;
+        }
+        if (population_steady(&stats, steady_tolerance)) {
+            stop = "steady";
+            break;
+        }
+    }
+    control_stop(&control);
+    if (world_food_model(world) == FOOD_FIELD) {
+        printf("Step %lld: life forms %d, food field %.3f\n", world_step_count(world), world_life_form_count(world),
+               world_field_total(world));
+    } else {
+        printf("Step %lld: life forms %d, food %d\n", world_step_count(world), world_life_form_count(world),
+               world_food_count(world));
+    }
+    if (strcmp(stop, "control") == 0) {
+        printf("Stopped early: stop command on the control socket\n");
+    } else if (strcmp(stop, "steps") != 0) {
+        printf("Stopped early: population %s\n", stop);
+    }
+    if (json && ok) {
+        print_run_json(world, scenario_name, stop, &stats);
+    }
+    if (validation_mode != VALIDATE_OFF && ok) {
+        printf("Validated %lld steps (%s): optimized kernels match the reference\n",
+               world_step_count(world) - start_step, validation_mode == VALIDATE_EXACT ? "exact" : "tolerance");
+    }
+    stop_profiler(stdout);
+
+    world_destroy(world);
+    free(stats.window);
+    if (stats.event_log != NULL) fclose(stats.event_log);
+    return ok ? 0 : 1;
+}
+
+// --- Soak Mode ---
+// Runs a world headless for a very long time (10^9 steps by default) and samples resident memory,
+// step time, population and the food array every interval steps. Steps never allocate, so resident
+// memory must stay flat once warmed up, and at an unchanged population and food count (the length
+// of every nearest-food scan) a step must not get slower as the run goes on.
+
+// Returns the resident set size of the process in bytes, or -1 if it cannot be read
+long long read_rss_bytes() {
+    FILE* f = fopen("/proc/self/statm", "r");
+    if (f == NULL) {
+        return -1;
+    }
+    long long size = 0;
+    long long resident = -1;
+    if (fscanf(f, "%lld %lld", &size, &resident) != 2) {
+        resident = -1;
+    }
+    fclose(f);
+    return resident < 0 ? -1 : resident * sysconf(_SC_PAGESIZE);
+}
+
+// Parses the soak options (args[0] is "--soak") and runs the soak; returns 1 if memory grew or
+// step time drifted beyond the limits
+int soak_main(int argc, char* args[]) {
+    const char* scenario_name = "default";
+    const char* resume_path = NULL;
+    const char* csv_path = NULL;
+    unsigned long long seed = BENCH_DEFAULT_SEED;
+    long long steps = SOAK_DEFAULT_STEPS;
+    long long interval = SOAK_DEFAULT_INTERVAL;
+    int warmup_samples = SOAK_DEFAULT_WARMUP_SAMPLES;
+    double max_rss_growth_mb = SOAK_DEFAULT_MAX_RSS_GROWTH_MB;
+    double max_drift = SOAK_DEFAULT_MAX_DRIFT;
+
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 < argc && strcmp(args[i], "--scenario") == 0) {
+            scenario_name = args[++i];
+        } else if (i + 1 < argc && strcmp(args[i], "--resume") == 0) {
+            resume_path = args[++i];
+        } else if (i + 1 < argc && strcmp(args[i], "--seed") == 0) {
+            seed = strtoull(args[++i], NULL, 10);
+        } else if (i + 1 < argc && strcmp(args[i], "--steps") == 0) {
+            steps = atoll(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--interval") == 0) {
+            interval = atoll(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--warmup-samples") == 0) {
+            warmup_samples = atoi(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--max-rss-growth") == 0) {
+            max_rss_growth_mb = atof(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--max-drift") == 0) {
+            max_drift = atof(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--csv") == 0) {
+            csv_path = args[++i];
+        } else if (parse_common_option(argc, args, &i)) {
+            // Threading, world and profiler options
+        } else {
+            fprintf(stderr, "Unknown soak option: %s\n", args[i]);
+            return 2;
+        }
+    }
+    const BenchScenario* scenario = find_bench_scenario(scenario_name);
+    if (scenario == NULL) {
+        fprintf(stderr, "Unknown scenario: %s (use --bench --list)\n", scenario_name);
+        return 2;
+    }
+    if (steps < 0 || interval < 1 || warmup_samples < 0 || max_rss_growth_mb < 0 || max_drift <= 0
+        || !check_common_options()) {
+        return 2;
+    }
+
+    FILE* csv = NULL;
+    if (csv_path != NULL) {
+        csv = fopen(csv_path, "w");
+        if (csv == NULL) {
+            fprintf(stderr, "Could not open soak log %s\n", csv_path);
+            return 1;
+        }
+        fprintf(csv, "step,population_min,population_max,food_min,food_max,food_capacity,"
+                     "mean_step_ns,max_step_ns,rss_bytes\n");
+    }
+    World* world = prepare_world(scenario, resume_path, seed);
+    if (world == NULL || !start_profiler()) {
+        world_destroy(world);
+        if (csv != NULL) fclose(csv);
+        return 1;
+    }
+
+    printf("Soak: %s, %lld steps, sampling every %lld steps\n",
+           resume_path != NULL ? resume_path : scenario->name, steps, interval);
+
+    // Step-time baselines (ns) per population and food bucket, taken from the first sample after
+    // warm-up that stays within one bucket; 0 = not seen yet
+    double baseline_ns[SOAK_BUCKETS][SOAK_BUCKETS] = { { 0.0 } };
+    int max_food_sources = world_max_food_sources(world);
+    int population_bucket_width = world_max_life_forms(world) / SOAK_BUCKETS + 1;
+    int food_bucket_width = max_food_sources / SOAK_BUCKETS + 1;
+    long long baseline_rss = -1;
+    long long peak_rss = 0;
+    long long samples = 0;
+    int drifting_samples = 0;
+    int ok = 1;
+
+    long long end_step = world_step_count(world) + steps;
+    while (world_step_count(world) < end_step && ok) {
+        long long remaining = end_step - world_step_count(world);
+        long long window = remaining < interval ? remaining : interval;
+        int population_min = world_life_form_count(world), population_max = population_min;
+        int food_min = world_food_count(world), food_max = food_min;
+        double max_step_ns = 0.0;
+        double window_start = alife_now_ns();
+        for (long long i = 0; i < window; ++i) {
+            double step_start = alife_now_ns();
+            world_step(world);
+            double step_ns = alife_now_ns() - step_start;
+            int population = world_life_form_count(world);
+            int food = world_food_count(world);
+            if (step_ns > max_step_ns) max_step_ns = step_ns;
+            if (population < population_min) population_min = population;
+            if (population > population_max) population_max = population;
+            if (food < food_min) food_min = food;
+            if (food > food_max) food_max = food;
+        }
+        double mean_step_ns = (alife_now_ns() - window_start) / window;
+        long long rss = read_rss_bytes();
+        if (rss > peak_rss) peak_rss = rss;
+        samples++;
+
+        const char* verdict = "";
+        if (samples == warmup_samples + 1) {
+            baseline_rss = rss;
+        }
+        if (samples > warmup_samples) {
+            if (baseline_rss >= 0 && rss - baseline_rss > max_rss_growth_mb * 1024.0 * 1024.0) {
+                verdict = "  MEMORY GROWTH";
+                ok = 0;
+            }
+            int population_bucket = population_min / population_bucket_width;
+            int food_bucket = food_min / food_bucket_width;
+            if (population_bucket == population_max / population_bucket_width
+                && food_bucket == food_max / food_bucket_width) {
+                double* baseline = &baseline_ns[population_bucket][food_bucket];
+                if (*baseline == 0.0) {
+                    *baseline = mean_step_ns;
+                } else if (mean_step_ns > *baseline * (1.0 + max_drift)) {
+                    drifting_samples++;
+                    verdict = "  drift";
+                    if (drifting_samples >= SOAK_DRIFT_SAMPLES) {
+                        verdict = "  STEP TIME DRIFT";
+                        ok = 0;
+                    }
+                } else {
+                    drifting_samples = 0;
+                }
+            }
+        }
+
+        long long step = world_step_count(world);
+        printf("step %lld  population %d-%d  food %d-%d/%d  step mean %.2f us max %.2f us  rss %.1f MB%s\n",
+               step, population_min, population_max, food_min, food_max, max_food_sources,
+               mean_step_ns / 1e3, max_step_ns / 1e3, rss / (1024.0 * 1024.0), verdict);
+        fflush(stdout);
+        if (csv != NULL) {
+            fprintf(csv, "%lld,%d,%d,%d,%d,%d,%.1f,%.1f,%lld\n", step, population_min, population_max,
+                    food_min, food_max, max_food_sources, mean_step_ns, max_step_ns, rss);
+            fflush(csv);
+        }
+    }
+
+    if (ok) {
+        printf("Soak passed: %lld steps, %lld samples, rss baseline %.1f MB, peak %.1f MB\n", steps, samples,
+               baseline_rss / (1024.0 * 1024.0), peak_rss / (1024.0 * 1024.0));
+    } else {
+        printf("Soak FAILED at step %lld: %s than allowed (rss growth limit %.1f MB, step time drift limit %.0f%%)\n",
+               world_step_count(world), drifting_samples >= SOAK_DRIFT_SAMPLES ? "step time drifted further"
+                                                                                : "resident memory grew more",
+               max_rss_growth_mb, max_drift * 100.0);
+    }
+    stop_profiler(stdout);
+
+    world_destroy(world);
+    if (csv != NULL) fclose(csv);
+    return ok ? 0 : 1;
+}
+
+// --- Island Mode ---
+// Evolves a scenario on several islands at once, one thread per island (archipelago_*), and
+// reports every island's population and mean speed factor, the trait evolution acts on.
+
+// Returns the mean speed factor of the world's life forms, or 0 if there are none
+double mean_speed_factor(const World* world) {
+    const LifeForm* life_forms = world_life_forms(world);
+    int count = world_life_form_count(world);
+    double sum = 0.0;
+    for (int i = 0; i < count; ++i) {
+        sum += life_forms[i].speed_factor;
+    }
+    return count > 0 ? sum / count : 0.0;
+}
+
+// Prints one line with every island's population and mean speed factor
+void print_islands(Archipelago* archipelago) {
+    printf("Step %lld:", world_step_count(archipelago_island(archipelago, 0)));
+    for (int i = 0; i < archipelago_island_count(archipelago); ++i) {
+        const World* world = archipelago_island(archipelago, i);
+        printf(" %d (%.2f)", world_life_form_count(world), mean_speed_factor(world));
+    }
+    printf("\n");
+}
+
+// Parses the island options (args[0] is "--islands") and runs the islands
+int islands_main(int argc, char* args[]) {
+    const char* scenario_name = "default";
+    unsigned long long seed = BENCH_DEFAULT_SEED;
+    long long steps = ISLANDS_DEFAULT_STEPS;
+    long long report_every = 0;
+    IslandConfig islands;
+    archipelago_default_config(&islands);
+
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 < argc && strcmp(args[i], "--scenario") == 0) {
+            scenario_name = args[++i];
+        } else if (i + 1 < argc && strcmp(args[i], "--seed") == 0) {
+            seed = strtoull(args[++i], NULL, 10);
+        } else if (i + 1 < argc && strcmp(args[i], "--steps") == 0) {
+            steps = atoll(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--count") == 0) {
+            islands.islands = atoi(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--migration-interval") == 0) {
+            islands.migration_interval = atoi(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--migrants") == 0) {
+            islands.migrants = atoi(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--report-every") == 0) {
+            report_every = atoll(args[++i]);
+        } else if (parse_common_option(argc, args, &i)) {
+            // Threading, world and profiler options
+        } else {
+            fprintf(stderr, "Unknown island option: %s\n", args[i]);
+            return 2;
+        }
+    }
+    const BenchScenario* scenario = find_bench_scenario(scenario_name);
+    if (scenario == NULL) {
+        fprintf(stderr, "Unknown scenario: %s (use --bench --list)\n", scenario_name);
+        return 2;
+    }
+    if (steps < 0 || report_every < 0 || !check_common_options()) {
+        return 2;
+    }
+
+    WorldConfig config;
+    scenario_config(scenario, seed, &config);
+    Archipelago* archipelago = archipelago_create(&config, &islands);
+    if (archipelago == NULL) {
+        return 1;
+    }
+    if (!start_profiler()) {
+        archipelago_destroy(archipelago);
+        return 1;
+    }
+    printf("%d islands of %s (seeds %llu..%llu), %d migrants every %d steps; population (mean speed factor):\n",
+           islands.islands, scenario_name, seed, seed + islands.islands - 1, islands.migrants,
+           islands.migration_interval);
+    print_islands(archipelago);
+    double start_ns = alife_now_ns();
+    long long done = 0;
+    int ok = 1;
+    while (done < steps && ok) {
+        long long batch = report_every > 0 && report_every < steps - done ? report_every : steps - done;
+        long long completed = archipelago_run(archipelago, batch);
+        ok = completed == batch;
+        done += completed;
+        print_islands(archipelago);
+    }
+    double seconds = (alife_now_ns() - start_ns) * 1e-9;
+    printf("%lld steps on %d islands in %.3f s: %.0f island steps/s, %lld migrants moved\n", done, islands.islands,
+           seconds, seconds > 0 ? done * islands.islands / seconds : 0.0, archipelago_migrant_count(archipelago));
+    stop_profiler(stdout);
+    archipelago_destroy(archipelago);
+    return ok ? 0 : 1;
+}
+
+// --- GA Mode ---
+// Evolves world parameters with a generational GA (genetic.c): fitness is the mean population,
+// capped one below capacity, over short episodes of the scenario, run in parallel with one
+// preallocated world per job.
+
+// Parses the GA options (args[0] is "--ga") and runs the GA
+int ga_main(int argc, char* args[]) {
+    const char* scenario_name = "default";
+    const char* log_path = NULL;
+    const char* best_path = NULL;
+    unsigned long long seed = BENCH_DEFAULT_SEED;
+    GaConfig ga;
+    ga_default_config(&ga);
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    ga.jobs = cpus > 0 ? (int)cpus : 1;
+
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 < argc && strcmp(args[i], "--scenario") == 0) {
+            scenario_name = args[++i];
+        } else if (i + 1 < argc && strcmp(args[i], "--seed") == 0) {
+            seed = strtoull(args[++i], NULL, 10);
+        } else if (i + 1 < argc && strcmp(args[i], "--gene") == 0) {
+            if (ga.gene_count == GA_MAX_GENES) {
+                fprintf(stderr, "At most %d genes\n", GA_MAX_GENES);
+                return 2;
+            }
+            if (!parse_gene(args[++i], &ga.genes[ga.gene_count++])) {
+                return 2;
+            }
+        } else if (i + 1 < argc && strcmp(args[i], "--population") == 0) {
+            ga.population = atoi(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--generations") == 0) {
+            ga.generations = atoi(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--episodes") == 0) {
+            ga.episodes = atoi(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--episode-steps") == 0) {
+            ga.episode_steps = atoll(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--elite") == 0) {
+            ga.elite = atoi(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--tournament") == 0) {
+            ga.tournament = atoi(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--mutation-rate") == 0) {
+            ga.mutation_rate = atof(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--mutation-sigma") == 0) {
+            ga.mutation_sigma = atof(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--jobs") == 0) {
+            ga.jobs = atoi(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--log") == 0) {
+            log_path = args[++i];
+        } else if (i + 1 < argc && strcmp(args[i], "--best-out") == 0) {
+            best_path = args[++i];
+        } else if (parse_common_option(argc, args, &i)) {
+            // Threading, world and profiler options
+        } else {
+            fprintf(stderr, "Unknown GA option: %s\n", args[i]);
+            return 2;
+        }
+    }
+    const BenchScenario* scenario = find_bench_scenario(scenario_name);
+    if (scenario == NULL) {
+        fprintf(stderr, "Unknown scenario: %s (use --bench --list)\n", scenario_name);
+        return 2;
+    }
+    if (!check_common_options()) {
+        return 2;
+    }
+    if (ga.gene_count == 0) {
+        parse_gene("mutation-width:0:1", &ga.genes[ga.gene_count++]);
+        parse_gene("min-speed-factor:0.1:1", &ga.genes[ga.gene_count++]);
+        parse_gene("max-speed-factor:1:4", &ga.genes[ga.gene_count++]);
+    }
+    scenario_config(scenario, seed, &ga.base);
+    ga.base.pin = PIN_NONE; // Evaluation threads come and go; the worlds' pools would pin the main thread
+    for (int g = 0; g < ga.gene_count; ++g) {
+        if (strcmp(ga.genes[g].param->name, "sense-radius") == 0 && ga.base.params.sensing != SENSE_LOCAL) {
+            printf("Note: sense-radius only matters with --sensing local\n");
+        }
+    }
+
+    FILE* log = NULL;
+    if (log_path != NULL && (log = fopen(log_path, "w")) == NULL) {
+        fprintf(stderr, "Could not open GA log %s\n", log_path);
+        return 1;
+    }
+    printf("GA on %s: %d genomes, %d generations, %d episodes of %lld steps each, %d jobs\n", scenario_name,
+           ga.population, ga.generations, ga.episodes, ga.episode_steps, ga.jobs);
+    Genome best;
+    int ok = start_profiler() && run_ga(&ga, log, &best);
+    if (ok) {
+        printf("Best: fitness %.2f\n", best.fitness);
+        if (best_path != NULL) {
+            WorldParams params = ga.base.params;
+            EcologyParams ecology = ga.base.ecology;
+            apply_genome(&ga, &best, &params, &ecology);
+            ok = save_param_file(best_path, &params, &ecology);
+            if (ok) {
+                printf("Wrote the best parameters to %s (use with --params)\n", best_path);
+            }
+        }
+        stop_profiler(stdout);
+    }
+    if (log != NULL) fclose(log);
+    return ok ? 0 : 1;
+}
+
+// --- Branch Mode ---
+// Runs a scenario, forks it into what-if branches (world_fork) that each change one parameter, and
+// steps all branches concurrently, one thread each, to compare their outcomes.
+
+typedef struct {
+    World* world;
+    const char* what_if;   // NAME=VALUE, or NULL for the unchanged branch
+    long long steps;
+    long long completed;
+    pthread_t thread;
+} Branch;
+
+// Branch thread: steps its world
+void* run_branch(void* arg) {
+    Branch* branch = (Branch*)arg;
+    branch->completed = world_step_n(branch->world, branch->steps);
+    return NULL;
+}
+
+// Parses the branch options (args[0] is "--branches"), forks the branches and runs them
+int branches_main(int argc, char* args[]) {
+    const char* scenario_name = "default";
+    const char* resume_path = NULL;
+    unsigned long long seed = BENCH_DEFAULT_SEED;
+    long long steps = BRANCH_DEFAULT_STEPS;
+    long long branch_steps = BRANCH_DEFAULT_STEPS;
+    Branch branches[BRANCH_MAX];
+    memset(branches, 0, sizeof(branches));
+    int count = 1; // Branch 0 is the unchanged one
+
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 < argc && strcmp(args[i], "--scenario") == 0) {
+            scenario_name = args[++i];
+        } else if (i + 1 < argc && strcmp(args[i], "--resume") == 0) {
+            resume_path = args[++i];
+        } else if (i + 1 < argc && strcmp(args[i], "--seed") == 0) {
+            seed = strtoull(args[++i], NULL, 10);
+        } else if (i + 1 < argc && strcmp(args[i], "--steps") == 0) {
+            steps = atoll(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--branch-steps") == 0) {
+            branch_steps = atoll(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--what-if") == 0) {
+            if (count == BRANCH_MAX) {
+                fprintf(stderr, "At most %d branches\n", BRANCH_MAX - 1);
+                return 2;
+            }
+            branches[count++].what_if = args[++i];
+        } else if (parse_common_option(argc, args, &i)) {
+            // Threading, world and profiler options
+        } else {
+            fprintf(stderr, "Unknown branch option: %s\n", args[i]);
+            return 2;
+        }
+    }
+    const BenchScenario* scenario = find_bench_scenario(scenario_name);
+    if (scenario == NULL) {
+        fprintf(stderr, "Unknown scenario: %s (use --bench --list)\n", scenario_name);
+        return 2;
+    }
+    if (steps < 0 || branch_steps < 0 || !check_common_options()) {
+        return 2;
+    }
+
+    World* world = prepare_world(scenario, resume_path, seed);
+    if (world == NULL) {
+        return 1;
+    }
+    int ok = world_step_n(world, steps) == steps;
+    printf("Step %lld: life forms %d, food %d\n", world_step_count(world), world_life_form_count(world),
+           world_food_count(world));
+
+    // Fork every branch from the same state, then change its parameter
+    double fork_start_ns = alife_now_ns();
+    for (int b = 0; ok && b < count; ++b) {
+        branches[b].world = world_fork(world, thread_count);
+        branches[b].steps = branch_steps;
+        ok = branches[b].world != NULL;
+    }
+    double fork_ns = alife_now_ns() - fork_start_ns;
+    for (int b = 1; ok && b < count; ++b) {
+        WorldParams params = *world_params(world);
+        EcologyParams ecology = *world_ecology(world);
+        char name[64];
+        const char* equals = strchr(branches[b].what_if, '=');
+        if (equals == NULL || equals - branches[b].what_if >= (long)sizeof(name)) {
+            fprintf(stderr, "--what-if expects NAME=VALUE, e.g. food-respawn=0.4\n");
+            ok = 0;
+            break;
+        }
+        snprintf(name, sizeof(name), "%.*s", (int)(equals - branches[b].what_if), branches[b].what_if);
+        if (!set_param_value(name, equals + 1, &params, &ecology)) {
+            fprintf(stderr, "Invalid parameter or value: %s\n", branches[b].what_if);
+            ok = 0;
+            break;
+        }
+        ok = world_set_params(branches[b].world, &params) && world_set_ecology(branches[b].world, &ecology);
+    }
+
+    if (ok && start_profiler()) {
+        printf("Forked %d branch%s in %.1f us; %lld steps each:\n", count, count == 1 ? "" : "es", fork_ns * 1e-3,
+               branch_steps);
+        double start_ns = alife_now_ns();
+        int started = 1;
+        for (; started < count; ++started) {
+            if (pthread_create(&branches[started].thread, NULL, run_branch, &branches[started]) != 0) {
+                fprintf(stderr, "Could not start branch thread %d!\n", started);
+                ok = 0;
+                break;
+            }
+        }
+        run_branch(&branches[0]);
+        for (int b = 1; b < started; ++b) {
+            pthread_join(branches[b].thread, NULL);
+        }
+        double seconds = (alife_now_ns() - start_ns) * 1e-9;
+        for (int b = 0; b < started; ++b) {
+            const World* branch = branches[b].world;
+            ok = ok && branches[b].completed == branch_steps;
+            printf("  %-28s step %lld: life forms %d, food %d, mean speed factor %.3f\n",
+                   branches[b].what_if != NULL ? branches[b].what_if : "(unchanged)", world_step_count(branch),
+                   world_life_form_count(branch), world_food_count(branch), mean_speed_factor(branch));
+        }
+        printf("%d branches in %.3f s\n", started, seconds);
+        stop_profiler(stdout);
+    } else {
+        ok = 0;
+    }
+    for (int b = 0; b < count; ++b) {
+        world_destroy(branches[b].world);
+    }
+    world_destroy(world);
+    return ok ? 0 : 1;
+}
+
+// Prints command-line help
+void print_usage(const char* program) {
+    printf("Usage: %s --bench [options]  Run the headless benchmark suite, one JSON line per scenario\n", program);
+    printf("       %s --run [options]    Run the simulation headless, optionally capturing a checkpoint\n", program);
+    printf("       %s --soak [options]   Run for a very long time; fail on memory growth or step-time drift\n", program);
+    printf("       %s --islands [options] Evolve several worlds in parallel, exchanging migrants\n", program);
+    printf("       %s --ga [options]     Evolve world parameters with a genetic algorithm\n", program);
+    printf("       %s --branches [options] Fork a run into what-if branches and run them in parallel\n", program);
+    printf("\nBenchmark options:\n");
+    printf("  --scenario NAME   Run one scenario (default: all)\n");
+    printf("  --workload FILE   Replay a captured checkpoint instead (default %d steps per run)\n",
+           BENCH_DEFAULT_REPLAY_STEPS);
+    printf("  --list            List scenario names\n");
+    printf("  --runs N          Timed runs per scenario (default: %d)\n", BENCH_DEFAULT_RUNS);
+    printf("  --warmup N        Untimed warm-up runs (default: %d)\n", BENCH_DEFAULT_WARMUP);
+    printf("  --steps N         Override the scenario's step count\n");
+    printf("  --seed N          Random seed shared by all runs (default: %d)\n", BENCH_DEFAULT_SEED);
+    printf("  --assert-no-alloc Abort if any step after the first allocates (ALIFE_TRACK_ALLOCS builds)\n");
+    printf("\nRun options:\n");
+    printf("  --scenario NAME   Initial world of a benchmark scenario (default: default)\n");
+    printf("  --resume FILE     Start from a checkpoint instead\n");
+    printf("  --seed N          Random seed (default: %d)\n", BENCH_DEFAULT_SEED);
+    printf("  --steps N         Steps to run (default: 1000)\n");
+    printf("  --capture-at N    Save a checkpoint once step N has completed...\n");
+    printf("  --capture-out F   ...to file F (default: capture.alck)\n");
+    printf("  --hash-every N    Print a hash of the state every N steps and after the last one\n");
+    printf("  --event-log FILE  Write every birth, death and feeding to FILE as CSV\n");
+    printf("  --json            Also print a summary of the run as one JSON line\n");
+    printf("  --control PATH    Serve status queries and commands on a Unix-domain socket at PATH:\n");
+    printf("                    status, pause, resume, stop, checkpoint FILE, set NAME VALUE (one per line)\n");
+    printf("  --stop-extinct    Stop once no life form is left\n");
+    printf("  --stop-steady N   Stop once the population of the last N steps stayed within the tolerance...\n");
+    printf("  --steady-tolerance X ...of its maximum (default: %g)\n", STEADY_DEFAULT_TOLERANCE);
+    printf("  --validate MODE   Run every phase through the reference and the optimized kernels and stop at\n");
+    printf("                    the first difference; MODE is exact or tolerance\n");
+    printf("  --tolerance X     Relative tolerance of --validate tolerance (default: %g)\n", VALIDATE_DEFAULT_TOLERANCE);
+    printf("\nSoak options (--scenario, --resume and --seed as for --run):\n");
+    printf("  --steps N         Steps to run (default: %lld)\n", SOAK_DEFAULT_STEPS);
+    printf("  --interval N      Steps per sample (default: %d)\n", SOAK_DEFAULT_INTERVAL);
+    printf("  --warmup-samples N Samples before the baselines are taken (default: %d)\n", SOAK_DEFAULT_WARMUP_SAMPLES);
+    printf("  --max-rss-growth MB Resident memory growth over the baseline that fails (default: %g)\n",
+           SOAK_DEFAULT_MAX_RSS_GROWTH_MB);
+    printf("  --max-drift X     Step-time increase at constant population and food that fails when it lasts\n");
+    printf("                    %d samples (default: %g = %.0f%%)\n", SOAK_DRIFT_SAMPLES, SOAK_DEFAULT_MAX_DRIFT,
+           SOAK_DEFAULT_MAX_DRIFT * 100.0);
+    printf("  --csv FILE        Also write every sample to FILE as CSV\n");
+    printf("\nIsland options (--scenario and --seed as for --run; island i uses seed + i):\n");
+    printf("  --count N         Islands, one thread each (default: %d)\n", DEFAULT_ISLANDS);
+    printf("  --steps N         Steps every island runs (default: %d)\n", ISLANDS_DEFAULT_STEPS);
+    printf("  --migration-interval N  Steps between migrations (default: %d)\n", DEFAULT_MIGRATION_INTERVAL);
+    printf("  --migrants N      Life forms each island sends to the next per migration (default: %d)\n",
+           DEFAULT_MIGRANTS);
+    printf("  --report-every N  Also print the islands every N steps\n");
+    printf("  --threads and --pin apply per island: update threads of each world, placement of island threads\n");
+    printf("\nGA options (--scenario and --seed as for --run; fitness is the mean population over an episode,\n");
+    printf("capped one below capacity):\n");
+    printf("  --gene NAME:MIN:MAX Evolve parameter NAME (as in a parameter file) within [MIN, MAX]; repeatable\n");
+    printf("                    (default: mutation-width:0:1, min-speed-factor:0.1:1 and max-speed-factor:1:4)\n");
+    printf("  --population N    Genomes per generation (default: %d)\n", GA_DEFAULT_POPULATION);
+    printf("  --generations N   Generations (default: %d)\n", GA_DEFAULT_GENERATIONS);
+    printf("  --episodes N      Episodes per genome, each with another seed (default: %d)\n", GA_DEFAULT_EPISODES);
+    printf("  --episode-steps N Steps per episode (default: %d)\n", GA_DEFAULT_EPISODE_STEPS);
+    printf("  --elite N         Best genomes kept unchanged (default: %d)\n", GA_DEFAULT_ELITE);
+    printf("  --tournament N    Tournament size of parent selection (default: %d)\n", GA_DEFAULT_TOURNAMENT);
+    printf("  --mutation-rate P Chance that a gene mutates (default: %g)\n", GA_DEFAULT_MUTATION_RATE);
+    printf("  --mutation-sigma X Mutation size relative to the gene's range (default: %g)\n",
+           GA_DEFAULT_MUTATION_SIGMA);
+    printf("  --jobs N          Evaluation threads, one preallocated world each (default: number of CPUs)\n");
+    printf("  --log FILE        Write every generation to FILE as CSV\n");
+    printf("  --best-out FILE   Write the best parameters to FILE as a parameter file\n");
+    printf("\nBranch options (--scenario, --resume and --seed as for --run):\n");
+    printf("  --steps N         Steps before forking (default: %d)\n", BRANCH_DEFAULT_STEPS);
+    printf("  --branch-steps N  Steps of every branch, each on its own thread (default: %d)\n", BRANCH_DEFAULT_STEPS);
+    printf("  --what-if NAME=VALUE Add a branch with parameter NAME (as in a parameter file) set to VALUE;\n");
+    printf("                    repeatable; an unchanged branch always runs too\n");
+    printf("  --threads applies to the run before forking and to every branch\n");
+    printf("\nThe threading, world and profiler options below apply to all modes.\n");
+    print_common_options_usage();
+}
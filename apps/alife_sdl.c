@@ -0,0 +1,651 @@
+// Interactive SDL2 frontend: draws a libalife world every frame and keeps frame pacing statistics
+#define SDL_MAIN_HANDLED
+#include <stdio.h>    // For input/output operations (printf)
+#include <stdlib.h>   // For strtoull, atof
+#include <string.h>   // For parsing command-line options (strcmp)
+#include <time.h>     // For seeding the random number generator (time)
+#include <math.h>     // For mathematical functions (round, floor, ceil, sqrt)
+
+#include <SDL2/SDL.h>
+
+#include "alife.h"
+#include "app_options.h"
+#include "param_file.h"
+
+// --- Display Parameters ---
+#define SCALE_FACTOR 1.0 // 1 unit = 1 pixel for now, can be adjusted later
+
+#define LIFE_FORM_RADIUS_PX 8  // Radius in pixels for rendering
+#define FOOD_RADIUS_PX 3       // Radius in pixels for rendering
+#define SCENT_FULL_SHADE 20.0f // Scent drawn in full colour (a cell a life form sits on, at the default rates)
+
+// --- Frame Pacing Parameters ---
+#define DEFAULT_REFRESH_RATE 60        // Assumed display refresh rate (Hz) when SDL cannot report one
+#define FRAME_HISTOGRAM_BIN_MS 0.25    // Resolution of the frame-time histogram used for percentiles
+#define FRAME_HISTOGRAM_BINS 1000      // Frames slower than BINS * BIN_MS land in the last bin
+
+// --- Rewind Parameters ---
+#define DEFAULT_REWIND_MB 64 // Memory for the rewind buffer
+#define REWIND_COARSE 100    // Steps per rewind or step-forward key press with Shift
+
+// Parts of an interactive frame, timed separately by the frame pacing statistics
+typedef enum {
+    FRAME_SIMULATE, // world_step
+    FRAME_RENDER,   // draw_simulation_state
+    FRAME_PRESENT,  // SDL_RenderPresent (blocks on vsync)
+    FRAME_SLEEP,    // SDL_Delay
+    FRAME_OTHER,    // Event handling and everything else between frames
+    FRAME_PART_COUNT
+} FramePart;
+
+// SDL related global variables
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+const Uint8 scent_colors[2][3] = { { 156, 39, 176 }, { 255, 152, 0 } }; // Purple, then orange for the second scent field
+
+// The simulated world
+World* world = NULL;
+
+// Frame pacing statistics for the whole interactive session
+const char* frame_part_names[FRAME_PART_COUNT] = { "simulate", "render", "present", "sleep", "other" };
+double refresh_interval_ms = 1000.0 / DEFAULT_REFRESH_RATE;
+double frame_budget_ms = 0.0;       // Frames slower than this are logged as stutter; 0 = 1.5 refresh intervals
+long long frame_count = 0;
+double frame_mean_ms = 0.0;         // Running mean and sum of squared deviations (Welford)
+double frame_m2 = 0.0;
+double frame_max_ms = 0.0;
+double frame_part_total_ms[FRAME_PART_COUNT];
+double frame_part_max_ms[FRAME_PART_COUNT];
+long long frame_histogram[FRAME_HISTOGRAM_BINS];
+long long missed_vsync_intervals = 0;
+long long stutter_frames = 0;
+int previous_frame_population = 0;
+FILE* frame_log = NULL;             // Optional per-frame CSV log (--frame-log)
+
+// Runtime parameters: the values last handed to the world, which applies them at its next step
+WorldParams scheduled_params;
+EcologyParams scheduled_ecology;
+ParamWatch param_watch = { -1, "" }; // On --params FILE
+int panel_open = 0;                  // Parameter panel (P)
+int panel_selected = 0;              // Index into tunable_params
+
+// Rewind: Space pauses; "," and "." move through the buffered steps while paused
+int paused = 0;
+size_t rewind_mb = DEFAULT_REWIND_MB; // --rewind-mb, 0 = no rewind buffer
+int keyframe_interval = DEFAULT_KEYFRAME_INTERVAL;
+
+// --- Function Prototypes ---
+
+// SDL Initialization and Cleanup
+int init_sdl(int width, int height);
+void close_sdl();
+
+// Drawing functions
+void draw_circle(SDL_Renderer* renderer, int x, int y, int radius);
+void draw_grid(const float* cells, int columns, int rows, float full, Uint8 r, Uint8 g, Uint8 b);
+void draw_simulation_state();
+
+// Frame pacing
+double elapsed_ms(Uint64 start, Uint64 end);
+void frame_pacing_init();
+void frame_pacing_record(const double part_ms[FRAME_PART_COUNT]);
+double frame_percentile_ms(double fraction);
+void frame_pacing_report(FILE* out);
+
+// Runtime parameters
+void schedule_params(const WorldParams* params, const EcologyParams* ecology);
+void reload_param_file();
+void print_panel();
+void handle_panel_key(SDL_Keycode key, int coarse);
+
+// Rewind
+void move_in_time(int direction, int coarse);
+
+void print_usage(const char* program);
+
+// --- Main Function ---
+int main(int argc, char* args[]) {
+    // Interactive options
+    const char* frame_log_path = NULL;
+    unsigned long long seed = (unsigned long long)time(NULL);
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 < argc && strcmp(args[i], "--seed") == 0) {
+            seed = strtoull(args[++i], NULL, 10);
+        } else if (i + 1 < argc && strcmp(args[i], "--frame-log") == 0) {
+            frame_log_path = args[++i];
+        } else if (i + 1 < argc && strcmp(args[i], "--frame-budget") == 0) {
+            frame_budget_ms = atof(args[++i]);
+        } else if (i + 1 < argc && strcmp(args[i], "--rewind-mb") == 0) {
+            rewind_mb = strtoull(args[++i], NULL, 10);
+        } else if (i + 1 < argc && strcmp(args[i], "--keyframe-interval") == 0) {
+            keyframe_interval = atoi(args[++i]);
+        } else if (parse_common_option(argc, args, &i)) {
+            // Threading, world and profiler options
+        } else {
+            print_usage(args[0]);
+            return strcmp(args[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+    if (!check_common_options()) {
+        return 1;
+    }
+    if (frame_log_path != NULL) {
+        frame_log = fopen(frame_log_path, "w");
+        if (frame_log == NULL) {
+            fprintf(stderr, "Could not open frame log %s\n", frame_log_path);
+            return 1;
+        }
+    }
+
+    // Initialize SDL with a window the size of the world
+    WorldConfig config;
+    world_default_config(&config);
+    config.seed = seed;
+    apply_common_options(&config);
+    if (!init_sdl((int)(config.params.width * SCALE_FACTOR), (int)(config.params.height * SCALE_FACTOR))) {
+        printf("Failed to initialize SDL!\n");
+        return 1;
+    }
+
+    // Create the world
+    world = world_create(&config);
+    if (world == NULL || (autotune_enabled && !autotune_world(world, tuning_cache_path, autotune_threads))
+        || !world_enable_rewind(world, rewind_mb << 20, keyframe_interval)) {
+        world_destroy(world);
+        close_sdl();
+        return 1;
+    }
+#ifdef ALIFE_PROFILER
+    if (profiler_enabled && !alife_profiler_start(profiler_hz)) {
+        profiler_enabled = 0;
+    }
+#endif
+    scheduled_params = *world_params(world);
+    scheduled_ecology = *world_ecology(world);
+    if (param_file_path != NULL && param_watch_start(&param_watch, param_file_path)) {
+        printf("Watching %s: saved changes apply at the next step\n", param_file_path);
+    }
+
+    // Main simulation loop flag
+    int quit = 0;
+    SDL_Event e;
+
+    printf("Artificial Life Simulator (C Language with SDL2)\n");
+    printf("----------------------------------------------\n");
+    printf("Press ESC or close the window to quit, C to capture a checkpoint, P for the parameter panel.\n");
+    if (rewind_mb > 0) {
+        printf("Space pauses; while paused, \",\" rewinds and \".\" steps forward (Shift: %d steps).\n", REWIND_COARSE);
+    }
+    printf("Seed: %llu, Life forms: %d, Food: %d, Kernels: %s\n", world_seed(world), world_life_form_count(world),
+           world_food_count(world), world_kernel_name(world));
+
+    frame_pacing_init();
+    Uint64 frame_start = SDL_GetPerformanceCounter();
+
+    // Game loop
+    while (!quit) {
+        // Handle events on queue
+        while (SDL_PollEvent(&e) != 0) {
+            // User requests quit
+            if (e.type == SDL_QUIT) {
+                quit = 1;
+            }
+            // User presses a key
+            if (e.type == SDL_KEYDOWN) {
+                if (e.key.keysym.sym == SDLK_ESCAPE) {
+                    quit = 1; // Quit on ESC key
+                } else if (e.key.keysym.sym == SDLK_c) {
+                    // Capture the current state, e.g. to add it to the benchmark workloads
+                    char path[64];
+                    snprintf(path, sizeof(path), "capture-%llu-%lld.alck", world_seed(world),
+                             world_step_count(world));
+                    if (world_save_checkpoint(world, path)) {
+                        printf("Captured step %lld to %s\n", world_step_count(world), path);
+                    }
+                } else if (e.key.keysym.sym == SDLK_SPACE) {
+                    paused = !paused;
+                    printf("%s at step %lld\n", paused ? "Paused" : "Resumed", world_step_count(world));
+                } else if (e.key.keysym.sym == SDLK_COMMA || e.key.keysym.sym == SDLK_PERIOD) {
+                    move_in_time(e.key.keysym.sym == SDLK_COMMA ? -1 : 1, (e.key.keysym.mod & KMOD_SHIFT) != 0);
+                } else if (e.key.keysym.sym == SDLK_p) {
+                    panel_open = !panel_open;
+                    if (panel_open) {
+                        print_panel();
+                    } else {
+                        printf("Parameter panel closed\n");
+                    }
+                } else if (panel_open) {
+                    handle_panel_key(e.key.keysym.sym, (e.key.keysym.mod & KMOD_SHIFT) != 0);
+                }
+            }
+        }
+        if (param_watch_poll(&param_watch)) {
+            reload_param_file();
+        }
+
+        // Every part of the frame is timed for the pacing statistics
+        double part_ms[FRAME_PART_COUNT];
+        Uint64 part_start = SDL_GetPerformanceCounter();
+
+        // --- Simulation Logic Update ---
+        if (!paused) {
+            world_step(world);
+        }
+
+        Uint64 part_end = SDL_GetPerformanceCounter();
+        part_ms[FRAME_SIMULATE] = elapsed_ms(part_start, part_end);
+        part_start = part_end;
+
+        // --- Render ---
+        draw_simulation_state();
+
+        part_end = SDL_GetPerformanceCounter();
+        part_ms[FRAME_RENDER] = elapsed_ms(part_start, part_end);
+        part_start = part_end;
+
+        // Update screen
+        SDL_RenderPresent(gRenderer);
+
+        part_end = SDL_GetPerformanceCounter();
+        part_ms[FRAME_PRESENT] = elapsed_ms(part_start, part_end);
+        part_start = part_end;
+
+        // Optional: Add a small delay to control simulation speed
+        SDL_Delay(10); // Adjust for desired speed
+
+        part_end = SDL_GetPerformanceCounter();
+        part_ms[FRAME_SLEEP] = elapsed_ms(part_start, part_end);
+        part_ms[FRAME_OTHER] = elapsed_ms(frame_start, part_end) - part_ms[FRAME_SIMULATE]
+                               - part_ms[FRAME_RENDER] - part_ms[FRAME_PRESENT] - part_ms[FRAME_SLEEP];
+        frame_start = part_end;
+        frame_pacing_record(part_ms);
+    }
+
+    printf("\nSimulation ended.\n");
+    frame_pacing_report(stdout);
+    if (frame_log != NULL) {
+        fclose(frame_log);
+    }
+#ifdef ALIFE_TRACK_ALLOCS
+    alife_alloc_print_report(stdout);
+#endif
+#ifdef ALIFE_PROFILER
+    if (profiler_enabled) {
+        alife_profiler_stop();
+        alife_profiler_report(stdout);
+    }
+#endif
+
+    // Destroy the world and close SDL subsystems
+    param_watch_stop(&param_watch);
+    world_destroy(world);
+    close_sdl();
+
+    return 0;
+}
+
+// --- Function Implementations ---
+
+// Initializes SDL and creates a window/renderer of the given size in pixels
+int init_sdl(int width, int height) {
+    // Initialize SDL
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        return 0;
+    }
+
+    // Create window
+    gWindow = SDL_CreateWindow("Artificial Life Simulator", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, width, height, SDL_WINDOW_SHOWN);
+    if (gWindow == NULL) {
+        printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+        return 0;
+    }
+
+    // Create renderer for window
+    gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    if (gRenderer == NULL) {
+        printf("Renderer could not be created! SDL_Error: %s\n", SDL_GetError());
+        return 0;
+    }
+
+    SDL_SetRenderDrawBlendMode(gRenderer, SDL_BLENDMODE_BLEND); // For the food and scent fields
+
+    // Set render color to light blue background
+    SDL_SetRenderDrawColor(gRenderer, 173, 216, 230, 255); // Light sky blue
+
+    return 1;
+}
+
+// Closes SDL subsystems and destroys window/renderer
+void close_sdl() {
+    // Destroy renderer
+    if (gRenderer != NULL) {
+        SDL_DestroyRenderer(gRenderer);
+        gRenderer = NULL;
+    }
+
+    // Destroy window
+    if (gWindow != NULL) {
+        SDL_DestroyWindow(gWindow);
+        gWindow = NULL;
+    }
+
+    // Quit SDL subsystems
+    SDL_Quit();
+}
+
+// Draws a filled circle using SDL_RenderDrawPoint
+// This is a basic implementation and can be optimized or replaced with SDL_gfx
+void draw_circle(SDL_Renderer* renderer, int x, int y, int radius) {
+    for (int i = x - radius; i <= x + radius; i++) {
+        for (int j = y - radius; j <= y + radius; j++) {
+            if ((i - x) * (i - x) + (j - y) * (j - y) <= radius * radius) {
+                SDL_RenderDrawPoint(renderer, i, j);
+            }
+        }
+    }
+}
+
+// Draws a grid spanning the world (food or scent field; nothing if cells is NULL), each cell in the
+// given colour with an opacity that grows with its value up to full
+void draw_grid(const float* cells, int columns, int rows, float full, Uint8 r, Uint8 g, Uint8 b) {
+    double cell_width = world_params(world)->width / columns * SCALE_FACTOR;
+    double cell_height = world_params(world)->height / rows * SCALE_FACTOR;
+    for (int y = 0; cells != NULL && y < rows; ++y) {
+        for (int x = 0; x < columns; ++x) {
+            float shade = cells[y * columns + x] / full;
+            if (shade <= 0) {
+                continue;
+            }
+            SDL_SetRenderDrawColor(gRenderer, r, g, b, (Uint8)(255 * (shade < 1 ? shade : 1)));
+            SDL_Rect cell = { (int)round(x * cell_width), (int)round(y * cell_height),
+                              (int)round((x + 1) * cell_width) - (int)round(x * cell_width),
+                              (int)round((y + 1) * cell_height) - (int)round(y * cell_height) };
+            SDL_RenderFillRect(gRenderer, &cell);
+        }
+    }
+}
+
+// Renders the current state of the simulation using SDL2
+void draw_simulation_state() {
+    // Clear screen
+    SDL_SetRenderDrawColor(gRenderer, 173, 216, 230, 255); // Light sky blue background
+    SDL_RenderClear(gRenderer);
+
+    // Draw the food field in food green, then the scent fields over it
+    int columns, rows;
+    world_field_size(world, &columns, &rows);
+    draw_grid(world_field(world), columns, rows, 1.0f, 76, 175, 80);
+    for (int i = 0; i < world_scent_fields(world); ++i) {
+        const float* scent = world_scent(world, i, &columns, &rows);
+        draw_grid(scent, columns, rows, SCENT_FULL_SHADE, scent_colors[i % 2][0], scent_colors[i % 2][1],
+                  scent_colors[i % 2][2]);
+    }
+
+    // Draw food sources
+    const Food* food_sources = world_food(world);
+    int food_count = world_food_count(world);
+    SDL_SetRenderDrawColor(gRenderer, 76, 175, 80, 255); // Green for food
+    for (int i = 0; i < food_count; ++i) {
+        if (food_sources[i].is_present) {
+            // Convert simulation coordinates to pixel coordinates
+            int px = (int)round(food_sources[i].x * SCALE_FACTOR);
+            int py = (int)round(food_sources[i].y * SCALE_FACTOR);
+            draw_circle(gRenderer, px, py, FOOD_RADIUS_PX);
+        }
+    }
+
+    // Draw life forms
+    const LifeForm* life_forms = world_life_forms(world);
+    int life_form_count = world_life_form_count(world);
+    for (int i = 0; i < life_form_count; ++i) {
+        const LifeForm* lf = &life_forms[i];
+        double energy = world_life_form_energy(world, lf);
+        if (energy > 0) {
+            // Set life form's color
+            SDL_SetRenderDrawColor(gRenderer, lf->r, lf->g, lf->b, 255);
+
+            // Convert simulation coordinates to pixel coordinates
+            int px = (int)round(lf->x * SCALE_FACTOR);
+            int py = (int)round(lf->y * SCALE_FACTOR);
+            draw_circle(gRenderer, px, py, LIFE_FORM_RADIUS_PX);
+
+            // Draw energy bar (optional, simpler for graphical output)
+            // Energy bar color from green to red
+            Uint8 energy_r = (Uint8)(255 * (1 - (energy / MAX_ENERGY)));
+            Uint8 energy_g = (Uint8)(255 * (energy / MAX_ENERGY));
+            SDL_SetRenderDrawColor(gRenderer, energy_r, energy_g, 0, 255);
+            SDL_Rect energy_bar = { px - LIFE_FORM_RADIUS_PX, py - LIFE_FORM_RADIUS_PX - 5,
+                                    (int)(LIFE_FORM_RADIUS_PX * 2 * (energy / MAX_ENERGY)), 3 };
+            SDL_RenderFillRect(gRenderer, &energy_bar);
+        }
+    }
+
+    // The caller presents the frame (SDL_RenderPresent), so presentation is timed separately
+}
+
+// --- Frame Pacing ---
+
+// Milliseconds between two SDL performance counter readings
+double elapsed_ms(Uint64 start, Uint64 end) {
+    return (double)(end - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+// Queries the display refresh rate, derives the frame budget and writes the frame log header
+void frame_pacing_init() {
+    SDL_DisplayMode mode;
+    int display = SDL_GetWindowDisplayIndex(gWindow);
+    if (display >= 0 && SDL_GetCurrentDisplayMode(display, &mode) == 0 && mode.refresh_rate > 0) {
+        refresh_interval_ms = 1000.0 / mode.refresh_rate;
+    }
+    if (frame_budget_ms <= 0.0) {
+        frame_budget_ms = 1.5 * refresh_interval_ms; // Slower than this means a vsync was missed
+    }
+    previous_frame_population = world_life_form_count(world);
+    if (frame_log != NULL) {
+        fprintf(frame_log, "frame,total_ms");
+        for (int p = 0; p < FRAME_PART_COUNT; ++p) {
+            fprintf(frame_log, ",%s_ms", frame_part_names[p]);
+        }
+        fprintf(frame_log, ",missed_vsyncs,life_forms,food\n");
+    }
+}
+
+// Adds one frame to the pacing statistics, and logs a breakdown when it exceeded its budget
+void frame_pacing_record(const double part_ms[FRAME_PART_COUNT]) {
+    double total_ms = 0.0;
+    int worst_part = 0;
+    for (int p = 0; p < FRAME_PART_COUNT; ++p) {
+        total_ms += part_ms[p];
+        frame_part_total_ms[p] += part_ms[p];
+        if (part_ms[p] > frame_part_max_ms[p]) frame_part_max_ms[p] = part_ms[p];
+        if (part_ms[p] > part_ms[worst_part]) worst_part = p;
+    }
+
+    // Welford's running mean and variance
+    frame_count++;
+    double delta = total_ms - frame_mean_ms;
+    frame_mean_ms += delta / frame_count;
+    frame_m2 += delta * (total_ms - frame_mean_ms);
+    if (total_ms > frame_max_ms) frame_max_ms = total_ms;
+
+    int bin = (int)(total_ms / FRAME_HISTOGRAM_BIN_MS);
+    if (bin >= FRAME_HISTOGRAM_BINS) bin = FRAME_HISTOGRAM_BINS - 1;
+    frame_histogram[bin]++;
+
+    // A frame that spans n refresh intervals has missed n - 1 vsyncs
+    int missed = (int)floor(total_ms / refresh_interval_ms + 0.5) - 1;
+    if (missed < 0) missed = 0;
+    missed_vsync_intervals += missed;
+
+    int life_form_count = world_life_form_count(world);
+    int food_count = world_food_count(world);
+    if (total_ms > frame_budget_ms) {
+        stutter_frames++;
+        fprintf(stderr, "Stutter: frame %lld took %.2f ms (budget %.2f ms, %d vsync(s) missed):",
+                frame_count, total_ms, frame_budget_ms, missed);
+        for (int p = 0; p < FRAME_PART_COUNT; ++p) {
+            fprintf(stderr, " %s %.2f", frame_part_names[p], part_ms[p]);
+        }
+        fprintf(stderr, "; worst: %s; life forms %d (%+d), food %d\n", frame_part_names[worst_part],
+                life_form_count, life_form_count - previous_frame_population, food_count);
+    }
+    previous_frame_population = life_form_count;
+
+    if (frame_log != NULL) {
+        fprintf(frame_log, "%lld,%.3f", frame_count, total_ms);
+        for (int p = 0; p < FRAME_PART_COUNT; ++p) {
+            fprintf(frame_log, ",%.3f", part_ms[p]);
+        }
+        fprintf(frame_log, ",%d,%d,%d\n", missed, life_form_count, food_count);
+    }
+}
+
+// Frame time below which the given fraction of frames fall (histogram resolution)
+double frame_percentile_ms(double fraction) {
+    long long target = (long long)ceil(fraction * frame_count);
+    long long seen = 0;
+    for (int bin = 0; bin < FRAME_HISTOGRAM_BINS; ++bin) {
+        seen += frame_histogram[bin];
+        if (seen >= target) {
+            return (bin + 1) * FRAME_HISTOGRAM_BIN_MS;
+        }
+    }
+    return FRAME_HISTOGRAM_BINS * FRAME_HISTOGRAM_BIN_MS;
+}
+
+// Prints the session's frame pacing statistics
+void frame_pacing_report(FILE* out) {
+    if (frame_count == 0) {
+        return;
+    }
+    double variance = frame_count > 1 ? frame_m2 / (frame_count - 1) : 0.0;
+    fprintf(out, "Frame pacing: %lld frames, mean %.2f ms, stddev %.2f ms (variance %.3f ms^2), max %.2f ms\n",
+            frame_count, frame_mean_ms, sqrt(variance), variance, frame_max_ms);
+    fprintf(out, "  p50 <= %.2f ms, p95 <= %.2f ms, p99 <= %.2f ms\n",
+            frame_percentile_ms(0.50), frame_percentile_ms(0.95), frame_percentile_ms(0.99));
+    fprintf(out, "  refresh interval %.2f ms; missed vsync intervals: %lld; frames over %.2f ms budget: %lld\n",
+            refresh_interval_ms, missed_vsync_intervals, frame_budget_ms, stutter_frames);
+    fprintf(out, "  %-10s %10s %10s\n", "part", "mean ms", "max ms");
+    for (int p = 0; p < FRAME_PART_COUNT; ++p) {
+        fprintf(out, "  %-10s %10.3f %10.3f\n", frame_part_names[p],
+                frame_part_total_ms[p] / frame_count, frame_part_max_ms[p]);
+    }
+}
+
+// --- Runtime Parameters ---
+// The parameter file (--params) is reloaded whenever it is saved, and the panel changes one
+// parameter per key press. Either way the world applies the new values at its next step boundary
+// and keeps its population.
+
+// Hands new parameters to the world and resizes the window to a new world size
+void schedule_params(const WorldParams* params, const EcologyParams* ecology) {
+    if (!world_set_params(world, params) || !world_set_ecology(world, ecology)) {
+        return; // Rejected, already reported; the world keeps its parameters
+    }
+    if (params->width != scheduled_params.width || params->height != scheduled_params.height) {
+        SDL_SetWindowSize(gWindow, (int)(params->width * SCALE_FACTOR), (int)(params->height * SCALE_FACTOR));
+    }
+    scheduled_params = *params;
+    scheduled_ecology = *ecology;
+}
+
+// Reads the changed parameter file over the current parameters
+void reload_param_file() {
+    WorldParams params = scheduled_params;
+    EcologyParams ecology = scheduled_ecology;
+    if (load_param_file(param_file_path, &params, &ecology)) {
+        schedule_params(&params, &ecology);
+        printf("Reloaded %s at step %lld\n", param_file_path, world_step_count(world));
+        if (panel_open) {
+            print_panel();
+        }
+    }
+}
+
+// Prints every tunable parameter, marking the selected one
+void print_panel() {
+    printf("Parameters (Up/Down select, Left/Right change, Shift x10, B boundary, G sensing, S save, P close):\n");
+    for (int i = 0; i < tunable_param_count; ++i) {
+        printf("  %s %-24s %g\n", i == panel_selected ? ">" : " ", tunable_params[i].name,
+               *tunable_value(&tunable_params[i], &scheduled_params, &scheduled_ecology));
+    }
+    printf("    %-24s %s\n    %-24s %s\n", "boundary", boundary_policy_name(scheduled_params.boundary), "sensing",
+           sensing_mode_name(scheduled_params.sensing));
+}
+
+// Handles a key press while the panel is open
+void handle_panel_key(SDL_Keycode key, int coarse) {
+    WorldParams params = scheduled_params;
+    EcologyParams ecology = scheduled_ecology;
+    const TunableParam* selected = &tunable_params[panel_selected];
+    double* value = tunable_value(selected, &params, &ecology);
+    if (key == SDLK_UP || key == SDLK_DOWN) {
+        panel_selected = (panel_selected + (key == SDLK_UP ? tunable_param_count - 1 : 1)) % tunable_param_count;
+        printf("> %s = %g\n", tunable_params[panel_selected].name,
+               *tunable_value(&tunable_params[panel_selected], &scheduled_params, &scheduled_ecology));
+        return;
+    } else if (key == SDLK_LEFT || key == SDLK_RIGHT) {
+        *value += (key == SDLK_RIGHT ? 1 : -1) * selected->step * (coarse ? 10 : 1);
+    } else if (key == SDLK_b) {
+        params.boundary = (BoundaryPolicy)((params.boundary + 1) % BOUNDARY_POLICY_COUNT);
+    } else if (key == SDLK_g) {
+        params.sensing = (SensingMode)((params.sensing + 1) % SENSING_MODE_COUNT);
+    } else if (key == SDLK_s) {
+        if (param_file_path == NULL) {
+            printf("Start with --params FILE to save the parameters\n");
+        } else if (save_param_file(param_file_path, &scheduled_params, &scheduled_ecology)) {
+            printf("Saved the parameters to %s\n", param_file_path);
+        }
+        return;
+    } else {
+        return;
+    }
+    schedule_params(&params, &ecology);
+    printf("> %s = %g, boundary %s, sensing %s (from step %lld)\n", selected->name,
+           *tunable_value(selected, &scheduled_params, &scheduled_ecology),
+           boundary_policy_name(scheduled_params.boundary), sensing_mode_name(scheduled_params.sensing),
+           world_step_count(world));
+}
+
+// --- Rewind ---
+
+// Rewinds (direction -1) or steps forward (1) one step, or REWIND_COARSE steps. Pauses first: a
+// running world would step on at once and discard the steps after the current one. Stepping
+// forward past the newest buffered step simulates new steps.
+void move_in_time(int direction, int coarse) {
+    paused = 1;
+    long long steps = coarse ? REWIND_COARSE : 1;
+    long long moved;
+    if (direction < 0) {
+        moved = -world_rewind(world, steps);
+    } else {
+        moved = world_forward(world, steps);
+        for (; moved < steps; ++moved) {
+            world_step(world);
+        }
+    }
+    // Moving restores the parameters recorded with the step and drops scheduled changes
+    const WorldParams* params = world_params(world);
+    if (params->width != scheduled_params.width || params->height != scheduled_params.height) {
+        SDL_SetWindowSize(gWindow, (int)(params->width * SCALE_FACTOR), (int)(params->height * SCALE_FACTOR));
+    }
+    scheduled_params = *params;
+    scheduled_ecology = *world_ecology(world);
+    printf("Step %lld (%+lld): %d life forms, %d food; %lld steps back and %lld ahead buffered in %.1f MiB\n",
+           world_step_count(world), moved, world_life_form_count(world), world_food_count(world),
+           world_rewind_depth(world), world_forward_depth(world), world_rewind_bytes(world) / 1048576.0);
+}
+
+// Prints command-line help
+void print_usage(const char* program) {
+    printf("Usage: %s [options]  Run the simulation in a window (headless modes: alife_headless)\n", program);
+    printf("\nOptions:\n");
+    printf("  --seed N          Random seed (default: current time)\n");
+    printf("  --frame-log FILE  Write per-frame timings to FILE as CSV\n");
+    printf("  --frame-budget MS Frames slower than this are reported as stutter (default: 1.5 refresh intervals)\n");
+    printf("  --rewind-mb N     Memory for rewinding, in MiB; 0 disables it (default: %d)\n", DEFAULT_REWIND_MB);
+    printf("  --keyframe-interval N  Steps between full states in the rewind buffer (default: %d)\n",
+           DEFAULT_KEYFRAME_INTERVAL);
+    print_common_options_usage();
+}
@@ -0,0 +1,314 @@
+#include <stdio.h>    // For error messages (fprintf) and --world (sscanf)
+#include <stdlib.h>   // For atoi, atof
+#include <string.h>   // For strcmp
+#include <math.h>     // For ceil (food field cells)
+#include <unistd.h>   // For sysconf (number of CPUs, the default --autotune-threads)
+
+#include "app_options.h"
+#include "param_file.h"
+
+int thread_count = 1;
+int chunk_size = DEFAULT_CHUNK_SIZE;
+PinStrategy pin_strategy = PIN_NONE;
+WorldParams option_params = { WORLD_WIDTH, WORLD_HEIGHT, LIFE_FORM_RADIUS, FOOD_RADIUS, SENSE_RADIUS,
+                             BOUNDARY_BOUNCE, SENSE_GLOBAL };
+#define DEFAULT_SCENT { SCENT_DEPOSIT, SCENT_DECAY, SCENT_DIFFUSION, SCENT_ATTRACTION }
+_Static_assert(MAX_SCENT_FIELDS == 2, "option_ecology needs one DEFAULT_SCENT per scent field");
+EcologyParams option_ecology = { REPRODUCTION_THRESHOLD, ENERGY_LOSS_PER_STEP, ENERGY_GAIN_FROM_FOOD, MUTATION_WIDTH,
+                                 MIN_SPEED_FACTOR, MAX_SPEED_FACTOR, FOOD_RESPAWN_CHANCE, FIELD_REGROWTH, FIELD_DIFFUSION, FIELD_GRAZE,
+                                 { DEFAULT_SCENT, DEFAULT_SCENT } };
+FoodModel food_model = FOOD_POINTS; // --food
+double field_cell_size = FIELD_CELL_SIZE; // --field-cell-size
+int scent_fields = 0; // --scent
+int use_generic_kernels = 0; // --generic-kernels
+EngineKind engine_kind = ENGINE_STEPPED; // --engine
+const char* param_file_path = NULL; // --params
+int autotune_enabled = 0; // --autotune
+int autotune_threads = 0; // --autotune-threads; 0 = number of CPUs
+const char* tuning_cache_path = TUNING_DEFAULT_CACHE; // --tuning-cache; NULL = none
+int invalid_world_option = 0;
+
+// World and ecology options as given, in order, to replay over a checkpoint's parameters on resume
+#define MAX_PARAM_OPTIONS 64
+static const char* param_options[MAX_PARAM_OPTIONS][2]; // Option and value
+static int param_option_count = 0;
+#ifdef ALIFE_PROFILER
+int profiler_enabled = 0; // --profile
+int profiler_hz = PROFILER_DEFAULT_HZ;
+#endif
+
+// Returns whether option (with its "--") sets world parameters or ecology, rather than the food model,
+// grids or threading that a checkpoint fixes
+static int is_param_option(const char* option) {
+    if (strcmp(option, "--world") == 0 || strcmp(option, "--params") == 0 || strcmp(option, "--boundary") == 0
+        || strcmp(option, "--sensing") == 0) {
+        return 1;
+    }
+    for (int i = 0; i < tunable_param_count; ++i) {
+        if (strcmp(option + 2, tunable_params[i].name) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Parses the options every mode accepts (threading, world parameters and ecology, and the profiler in
+// -DALIFE_PROFILER builds) at args[*i]; returns 1 (and advances *i past any value) if it was one of them
+int parse_common_option(int argc, char* args[], int* i) {
+    if (strcmp(args[*i], "--generic-kernels") == 0) {
+        use_generic_kernels = 1;
+        return 1;
+    }
+    if (strcmp(args[*i], "--autotune") == 0) {
+        autotune_enabled = 1;
+        return 1;
+    }
+#ifdef ALIFE_PROFILER
+    if (strcmp(args[*i], "--profile") == 0) {
+        profiler_enabled = 1;
+        return 1;
+    }
+    if (*i + 1 < argc && strcmp(args[*i], "--profile-hz") == 0) {
+        profiler_hz = atoi(args[++*i]);
+        return 1;
+    }
+#endif
+    if (*i + 1 >= argc) {
+        return 0;
+    }
+    if (strcmp(args[*i], "--threads") == 0) {
+        thread_count = atoi(args[++*i]);
+    } else if (strcmp(args[*i], "--chunk-size") == 0) {
+        chunk_size = atoi(args[++*i]);
+    } else if (strcmp(args[*i], "--autotune-threads") == 0) {
+        autotune_threads = atoi(args[++*i]);
+    } else if (strcmp(args[*i], "--tuning-cache") == 0) {
+        ++*i;
+        tuning_cache_path = strcmp(args[*i], "none") == 0 ? NULL : args[*i];
+    } else if (strcmp(args[*i], "--pin") == 0) {
+        int strategy = parse_pin_strategy(args[++*i]);
+        if (strategy < 0) {
+            fprintf(stderr, "Unknown pinning strategy: %s (none, compact or scatter)\n", args[*i]);
+            strategy = PIN_STRATEGY_COUNT; // Rejected by check_common_options
+        }
+        pin_strategy = (PinStrategy)strategy;
+    } else if (strcmp(args[*i], "--engine") == 0) {
+        int engine = parse_engine(args[++*i]);
+        if (engine < 0) {
+            fprintf(stderr, "Unknown engine: %s (stepped or event)\n", args[*i]);
+            engine = ENGINE_COUNT; // Rejected by check_common_options
+        }
+        engine_kind = (EngineKind)engine;
+    } else if (strcmp(args[*i], "--food") == 0) {
+        int model = parse_food_model(args[++*i]);
+        if (model < 0) {
+            fprintf(stderr, "Unknown food model: %s (points or field)\n", args[*i]);
+            invalid_world_option = 1;
+        } else {
+            food_model = (FoodModel)model;
+        }
+    } else if (strcmp(args[*i], "--field-cell-size") == 0) {
+        field_cell_size = atof(args[++*i]);
+    } else if (strcmp(args[*i], "--scent") == 0) {
+        scent_fields = atoi(args[++*i]);
+    } else if (strncmp(args[*i], "--scent", 7) == 0 && args[*i][7] >= '1' && args[*i][7] <= '9') {
+        // --scentN-deposit, --scentN-decay, --scentN-diffusion and --scentN-attraction, as in parameter files
+        if (!set_param_value(args[*i] + 2, args[*i + 1], &option_params, &option_ecology)) {
+            fprintf(stderr, "Unknown scent option or invalid value: %s %s\n", args[*i], args[*i + 1]);
+            invalid_world_option = 1;
+        }
+        ++*i;
+    } else if (strcmp(args[*i], "--world") == 0) {
+        if (sscanf(args[++*i], "%lfx%lf", &option_params.width, &option_params.height) != 2) {
+            fprintf(stderr, "--world expects WIDTHxHEIGHT, e.g. 800x600\n");
+            invalid_world_option = 1;
+        }
+    } else if (strcmp(args[*i], "--life-form-radius") == 0) {
+        option_params.life_form_radius = atof(args[++*i]);
+    } else if (strcmp(args[*i], "--food-radius") == 0) {
+        option_params.food_radius = atof(args[++*i]);
+    } else if (strcmp(args[*i], "--sense-radius") == 0) {
+        option_params.sense_radius = atof(args[++*i]);
+    } else if (strcmp(args[*i], "--boundary") == 0) {
+        int policy = parse_boundary_policy(args[++*i]);
+        if (policy < 0) {
+            fprintf(stderr, "Unknown boundary policy: %s (bounce or wrap)\n", args[*i]);
+            invalid_world_option = 1;
+        } else {
+            option_params.boundary = (BoundaryPolicy)policy;
+        }
+    } else if (strcmp(args[*i], "--sensing") == 0) {
+        int mode = parse_sensing_mode(args[++*i]);
+        if (mode < 0) {
+            fprintf(stderr, "Unknown sensing mode: %s (global or local)\n", args[*i]);
+            invalid_world_option = 1;
+        } else {
+            option_params.sensing = (SensingMode)mode;
+        }
+    } else if (strcmp(args[*i], "--params") == 0) {
+        param_file_path = args[++*i];
+        if (!load_param_file(param_file_path, &option_params, &option_ecology)) {
+            invalid_world_option = 1;
+        }
+    } else if (strcmp(args[*i], "--reproduction-threshold") == 0) {
+        option_ecology.reproduction_threshold = atof(args[++*i]);
+    } else if (strcmp(args[*i], "--energy-loss") == 0) {
+        option_ecology.energy_loss = atof(args[++*i]);
+    } else if (strcmp(args[*i], "--energy-gain") == 0) {
+        option_ecology.energy_gain = atof(args[++*i]);
+    } else if (strcmp(args[*i], "--mutation-width") == 0) {
+        option_ecology.mutation_width = atof(args[++*i]);
+    } else if (strcmp(args[*i], "--min-speed-factor") == 0) {
+        option_ecology.min_speed_factor = atof(args[++*i]);
+    } else if (strcmp(args[*i], "--max-speed-factor") == 0) {
+        option_ecology.max_speed_factor = atof(args[++*i]);
+    } else if (strcmp(args[*i], "--food-respawn") == 0) {
+        option_ecology.food_respawn_chance = atof(args[++*i]);
+    } else if (strcmp(args[*i], "--field-regrowth") == 0) {
+        option_ecology.field_regrowth = atof(args[++*i]);
+    } else if (strcmp(args[*i], "--field-diffusion") == 0) {
+        option_ecology.field_diffusion = atof(args[++*i]);
+    } else if (strcmp(args[*i], "--field-graze") == 0) {
+        option_ecology.field_graze = atof(args[++*i]);
+    } else {
+        return 0;
+    }
+    if (is_param_option(args[*i - 1])) {
+        if (param_option_count == MAX_PARAM_OPTIONS) {
+            fprintf(stderr, "Too many world options (at most %d)\n", MAX_PARAM_OPTIONS);
+            invalid_world_option = 1;
+        } else {
+            param_options[param_option_count][0] = args[*i - 1];
+            param_options[param_option_count][1] = args[*i];
+            ++param_option_count;
+        }
+    }
+    return 1;
+}
+
+// Validates the options parsed by parse_common_option; returns 0 (after printing why) if any is out of range
+int check_common_options() {
+#ifdef ALIFE_PROFILER
+    if (profiler_hz < 1 || profiler_hz > 1000000) {
+        fprintf(stderr, "--profile-hz must be between 1 and 1000000\n");
+        return 0;
+    }
+#endif
+    if (thread_count < 1 || thread_count > MAX_THREADS) {
+        fprintf(stderr, "--threads must be between 1 and %d\n", MAX_THREADS);
+        return 0;
+    }
+    if (chunk_size < 1) {
+        fprintf(stderr, "--chunk-size must be at least 1\n");
+        return 0;
+    }
+    if (!(field_cell_size > 0)) {
+        fprintf(stderr, "--field-cell-size must be positive\n");
+        return 0;
+    }
+    if (scent_fields < 0 || scent_fields > MAX_SCENT_FIELDS) {
+        fprintf(stderr, "--scent must be between 0 and %d\n", MAX_SCENT_FIELDS);
+        return 0;
+    }
+    if (autotune_threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        autotune_threads = cpus < 1 ? 1 : cpus > MAX_THREADS ? MAX_THREADS : (int)cpus;
+    }
+    if (autotune_threads < 1 || autotune_threads > MAX_THREADS) {
+        fprintf(stderr, "--autotune-threads must be between 1 and %d\n", MAX_THREADS);
+        return 0;
+    }
+    return pin_strategy < PIN_STRATEGY_COUNT && engine_kind < ENGINE_COUNT && !invalid_world_option;
+}
+
+// Copies the threading options, world parameters, ecology, food model and scent fields into a world
+// config; food and scent fields get as many cells of --field-cell-size as cover the world
+void apply_common_options(WorldConfig* config) {
+    config->threads = thread_count;
+    config->chunk_size = chunk_size;
+    config->pin = pin_strategy;
+    config->params = option_params;
+    config->ecology = option_ecology;
+    config->specialized = !use_generic_kernels;
+    config->engine = engine_kind;
+    config->food_model = food_model;
+    config->field_columns = (int)ceil(option_params.width / field_cell_size);
+    config->field_rows = (int)ceil(option_params.height / field_cell_size);
+    config->scent_fields = scent_fields;
+}
+
+// Applies the world and ecology options given on the command line to a world resumed from a
+// checkpoint, over the checkpoint's own parameters; returns 0 (after printing why) if the world
+// rejects the result. Options not given keep the checkpoint's values.
+int apply_param_options(World* world) {
+    if (param_option_count == 0) {
+        return 1;
+    }
+    WorldParams params = *world_params(world);
+    EcologyParams ecology = *world_ecology(world);
+    for (int i = 0; i < param_option_count; ++i) {
+        const char* option = param_options[i][0];
+        const char* value = param_options[i][1];
+        int ok = strcmp(option, "--world") == 0 ? sscanf(value, "%lfx%lf", &params.width, &params.height) == 2
+                 : strcmp(option, "--params") == 0 ? load_param_file(value, &params, &ecology)
+                 : set_param_value(option + 2, value, &params, &ecology);
+        if (!ok) {
+            fprintf(stderr, "Invalid value for %s: %s\n", option, value);
+            return 0;
+        }
+    }
+    return world_set_params(world, &params) && world_set_ecology(world, &ecology);
+}
+
+// Prints help for the options parse_common_option accepts
+void print_common_options_usage() {
+    printf("\nThreading options:\n");
+    printf("  --threads N       Threads for the update phase, including the main thread (default: 1)\n");
+    printf("  --chunk-size N    Life forms per work item (default: %d)\n", DEFAULT_CHUNK_SIZE);
+    printf("  --pin STRATEGY    Thread placement: none, compact or scatter (default: none)\n");
+    printf("  --autotune        Time thread counts, chunk sizes and kernels on the starting state and use the\n");
+    printf("                    fastest (--run, --soak and the interactive frontend); overrides the options above\n");
+    printf("  --autotune-threads N Most threads to try (default: number of CPUs)\n");
+    printf("  --tuning-cache FILE Reuse and record choices per machine and scenario, or none (default: %s)\n",
+           TUNING_DEFAULT_CACHE);
+    printf("  --engine ENGINE   stepped: search and check everything every step; event: only when a food\n");
+    printf("                    event can happen, faster in sparse worlds, same results (default: stepped)\n");
+    printf("\nWorld options (when resuming, those given override the checkpoint's parameters; --food,\n");
+    printf("--field-cell-size and --scent are the checkpoint's own):\n");
+    printf("  --params FILE     Read the parameters below from FILE (\"name = value\" lines, names without --);\n");
+    printf("                    later options override it, and the interactive frontend reloads it on change\n");
+    printf("  --world WxH       World size (default: %dx%d)\n", WORLD_WIDTH, WORLD_HEIGHT);
+    printf("  --life-form-radius R, --food-radius R  Collision radii (default: %g, %g)\n", LIFE_FORM_RADIUS,
+           FOOD_RADIUS);
+    printf("  --boundary POLICY bounce or wrap (default: bounce)\n");
+    printf("  --sensing MODE    global: seek the nearest food anywhere; local: only within the sense radius\n");
+    printf("  --sense-radius R  Sense radius of local sensing (default: %g)\n", SENSE_RADIUS);
+    printf("  --generic-kernels Use the runtime-parameter kernels even if the build has specialized ones\n");
+    printf("  --reproduction-threshold E  Energy at which a life form splits (default: %g)\n", REPRODUCTION_THRESHOLD);
+    printf("  --energy-loss E   Energy spent per step (default: %g)\n", ENERGY_LOSS_PER_STEP);
+    printf("  --energy-gain E   Energy of one food source (default: %g)\n", ENERGY_GAIN_FROM_FOOD);
+    printf("  --mutation-width W Range of the offspring speed factor mutation (default: %g)\n", MUTATION_WIDTH);
+    printf("  --min-speed-factor F, --max-speed-factor F  Range offspring speed factors are clamped to\n");
+    printf("                    (default: %g, %g)\n", MIN_SPEED_FACTOR, MAX_SPEED_FACTOR);
+    printf("  --food-respawn P  Chance that eaten food respawns (default: %g)\n", FOOD_RESPAWN_CHANCE);
+    printf("  --food MODEL      points: food sources that respawn; field: a grid of densities that regrow\n");
+    printf("                    and diffuse, grazed by the life forms on them (default: points)\n");
+    printf("  --field-cell-size S Edge of a food or scent field cell (default: %g)\n", FIELD_CELL_SIZE);
+    printf("  --field-regrowth R Share of its missing density a cell regrows per step (default: %g)\n",
+           FIELD_REGROWTH);
+    printf("  --field-diffusion D Share of the difference to each neighbour exchanged per step (default: %g)\n",
+           FIELD_DIFFUSION);
+    printf("  --field-graze G   Density a life form eats from its cell per step (default: %g)\n", FIELD_GRAZE);
+    printf("  --scent N         Scent fields life forms lay and follow, 0 to %d (default: 0)\n", MAX_SCENT_FIELDS);
+    printf("  --scentK-deposit D, --scentK-decay R, --scentK-diffusion S, --scentK-attraction A\n");
+    printf("                    Rates of scent field K: scent left per step (default: %g), share lost per step\n",
+           SCENT_DEPOSIT);
+    printf("                    (%g), share exchanged with each neighbour (%g), and velocity change per unit of\n",
+           SCENT_DECAY, SCENT_DIFFUSION);
+    printf("                    gradient (%g; negative to avoid the scent)\n", SCENT_ATTRACTION);
+#ifdef ALIFE_PROFILER
+    printf("\nProfiler options:\n");
+    printf("  --profile         Sample the program counter on SIGPROF; print hot functions and phases on exit\n");
+    printf("  --profile-hz N    Samples per second of CPU time (default: %d)\n", PROFILER_DEFAULT_HZ);
+#endif
+}
@@ -0,0 +1,37 @@
+#ifndef APP_OPTIONS_H
+#define APP_OPTIONS_H
+
+// Command-line options shared by the frontends (threading and its auto-tuning, world parameters and ecology,
+// and the profiler in -DALIFE_PROFILER builds)
+
+#include "alife.h"
+#include "tuning_cache.h"
+
+#define PROFILER_DEFAULT_HZ 1000 // Samples per second of CPU time
+
+extern int thread_count;
+extern int chunk_size;
+extern PinStrategy pin_strategy;
+extern WorldParams option_params;
+extern EcologyParams option_ecology;
+extern const char* param_file_path;
+extern int use_generic_kernels;
+extern EngineKind engine_kind;
+extern FoodModel food_model;
+extern double field_cell_size;
+extern int scent_fields;
+extern int autotune_enabled;
+extern int autotune_threads;
+extern const char* tuning_cache_path;
+#ifdef ALIFE_PROFILER
+extern int profiler_enabled;
+extern int profiler_hz;
+#endif
+
+int parse_common_option(int argc, char* args[], int* i);
+int check_common_options();
+void apply_common_options(WorldConfig* config);
+int apply_param_options(World* world);
+void print_common_options_usage();
+
+#endif // APP_OPTIONS_H
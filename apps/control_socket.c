@@ -0,0 +1,313 @@
+#define _GNU_SOURCE // For accept4 and MSG_NOSIGNAL
+#include <errno.h>      // For errno
+#include <stdio.h>      // For error messages (fprintf) and replies (snprintf)
+#include <string.h>     // For strcmp, strchr, memcpy, strerror
+#include <time.h>       // For nanosleep
+#include <unistd.h>     // For read, close, unlink
+#include <poll.h>       // For poll
+#include <sys/socket.h> // For socket, bind, listen, accept4, send
+#include <sys/stat.h>   // For chmod
+#include <sys/un.h>     // For sockaddr_un
+
+#include "control_socket.h"
+#include "param_file.h"
+
+#define CONTROL_POLL_MS 100      // Longest the server thread sleeps before checking whether to stop
+#define CONTROL_WAIT_NS 1000000  // Interval at which the server thread checks for a command's reply
+
+// A connected client and its partial request line
+typedef struct {
+    int fd;
+    size_t length;
+    char line[CONTROL_LINE_MAX];
+} ControlClient;
+
+// --- Server Thread ---
+
+static int is_stopping(ControlServer* server) {
+    pthread_mutex_lock(&server->lock);
+    int stopping = server->stopping;
+    pthread_mutex_unlock(&server->lock);
+    return stopping;
+}
+
+// Formats the last published status as one JSON line
+static void format_status(ControlServer* server, char* reply) {
+    pthread_mutex_lock(&server->lock);
+    ControlStatus status = server->status;
+    pthread_mutex_unlock(&server->lock);
+    int n = snprintf(reply, CONTROL_REPLY_MAX,
+                     "{\"step\":%lld,\"life_forms\":%d,\"food\":%d,\"paused\":%s,\"kernels\":\"%s\",\"elapsed_s\":%.3f,"
+                     "\"phase_ms\":{",
+                     status.step, status.life_forms, status.food, status.paused ? "true" : "false", status.kernels,
+                     status.elapsed_ns * 1e-9);
+    for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+        n += snprintf(reply + n, CONTROL_REPLY_MAX - n, "%s\"%s\":%.3f", phase > 0 ? "," : "",
+                      world_phase_name(phase), status.phase_ns[phase] * 1e-6);
+    }
+    snprintf(reply + n, CONTROL_REPLY_MAX - n, "}}");
+}
+
+// Posts a command to the simulation thread and waits for its reply
+static void run_command(ControlServer* server, ControlCommand command, const char* argument, char* reply) {
+    pthread_mutex_lock(&server->lock);
+    server->command = command;
+    snprintf(server->argument, sizeof(server->argument), "%s", argument);
+    server->replied = 0;
+    pthread_mutex_unlock(&server->lock);
+    const struct timespec wait = { 0, CONTROL_WAIT_NS };
+    for (;;) {
+        nanosleep(&wait, NULL);
+        pthread_mutex_lock(&server->lock);
+        int done = server->replied || server->stopping;
+        if (server->replied) {
+            memcpy(reply, server->reply, CONTROL_REPLY_MAX);
+        } else if (server->stopping) {
+            snprintf(reply, CONTROL_REPLY_MAX, "error: the run has finished");
+        }
+        if (done) {
+            server->command = CONTROL_NONE;
+        }
+        pthread_mutex_unlock(&server->lock);
+        if (done) {
+            return;
+        }
+    }
+}
+
+// Answers one request line into reply
+static void handle_request(ControlServer* server, char* line, char* reply) {
+    char* argument = strchr(line, ' ');
+    if (argument != NULL) {
+        *argument++ = '\0';
+        while (*argument == ' ') ++argument;
+    } else {
+        argument = line + strlen(line);
+    }
+    int has_argument = *argument != '\0';
+    if (strcmp(line, "status") == 0 && !has_argument) {
+        format_status(server, reply);
+    } else if (strcmp(line, "pause") == 0 && !has_argument) {
+        run_command(server, CONTROL_PAUSE, "", reply);
+    } else if (strcmp(line, "resume") == 0 && !has_argument) {
+        run_command(server, CONTROL_RESUME, "", reply);
+    } else if (strcmp(line, "stop") == 0 && !has_argument) {
+        run_command(server, CONTROL_STOP, "", reply);
+    } else if (strcmp(line, "checkpoint") == 0 && has_argument) {
+        run_command(server, CONTROL_CHECKPOINT, argument, reply);
+    } else if (strcmp(line, "set") == 0 && strchr(argument, ' ') != NULL) {
+        run_command(server, CONTROL_SET, argument, reply);
+    } else {
+        snprintf(reply, CONTROL_REPLY_MAX,
+                 "error: expected status, pause, resume, stop, checkpoint PATH or set NAME VALUE");
+    }
+}
+
+// Sends reply and a newline; returns 0 if the client cannot take it without blocking
+static int send_reply(int fd, const char* reply) {
+    char buffer[CONTROL_REPLY_MAX + 1];
+    int length = snprintf(buffer, sizeof(buffer), "%s\n", reply);
+    if (length > CONTROL_REPLY_MAX) length = CONTROL_REPLY_MAX; // Truncated: end with the newline anyway
+    buffer[length - 1] = '\n';
+    return send(fd, buffer, length, MSG_NOSIGNAL | MSG_DONTWAIT) == length;
+}
+
+// Reads what client sent and answers its complete lines; returns 0 once the client is gone
+static int serve_client(ControlServer* server, ControlClient* client) {
+    ssize_t n = read(client->fd, client->line + client->length, sizeof(client->line) - client->length);
+    if (n <= 0) {
+        return 0;
+    }
+    client->length += n;
+    char* newline;
+    while ((newline = memchr(client->line, '\n', client->length)) != NULL) {
+        *newline = '\0';
+        if (newline > client->line && newline[-1] == '\r') newline[-1] = '\0';
+        char reply[CONTROL_REPLY_MAX];
+        handle_request(server, client->line, reply);
+        if (!send_reply(client->fd, reply)) {
+            return 0;
+        }
+        size_t used = newline + 1 - client->line;
+        memmove(client->line, newline + 1, client->length - used);
+        client->length -= used;
+    }
+    if (client->length == sizeof(client->line)) {
+        send_reply(client->fd, "error: request too long");
+        return 0;
+    }
+    return 1;
+}
+
+// Accepts clients and answers their requests until control_stop
+static void* serve(void* arg) {
+    ControlServer* server = (ControlServer*)arg;
+    ControlClient clients[CONTROL_MAX_CLIENTS];
+    int client_count = 0;
+    while (!is_stopping(server)) {
+        struct pollfd fds[1 + CONTROL_MAX_CLIENTS];
+        fds[0].fd = server->listen_fd;
+        fds[0].events = POLLIN;
+        for (int i = 0; i < client_count; ++i) {
+            fds[1 + i].fd = clients[i].fd;
+            fds[1 + i].events = POLLIN;
+        }
+        if (poll(fds, 1 + client_count, CONTROL_POLL_MS) <= 0) {
+            continue;
+        }
+        // Clients first, while fds still matches the client array
+        for (int i = client_count - 1; i >= 0; --i) {
+            if (fds[1 + i].revents != 0 && !serve_client(server, &clients[i])) {
+                close(clients[i].fd);
+                clients[i] = clients[--client_count];
+            }
+        }
+        if (fds[0].revents & POLLIN) {
+            int fd = accept4(server->listen_fd, NULL, NULL, SOCK_CLOEXEC);
+            if (fd >= 0 && client_count == CONTROL_MAX_CLIENTS) {
+                send_reply(fd, "error: too many clients");
+                close(fd);
+            } else if (fd >= 0) {
+                clients[client_count].fd = fd;
+                clients[client_count].length = 0;
+                ++client_count;
+            }
+        }
+    }
+    for (int i = 0; i < client_count; ++i) {
+        close(clients[i].fd);
+    }
+    return NULL;
+}
+
+// --- Simulation Thread ---
+
+// Executes the posted command; called with the lock held
+static void execute_command(ControlServer* server, World* world) {
+    char* reply = server->reply;
+    snprintf(reply, CONTROL_REPLY_MAX, "ok");
+    switch (server->command) {
+    case CONTROL_PAUSE:
+        server->paused = 1;
+        break;
+    case CONTROL_RESUME:
+        server->paused = 0;
+        break;
+    case CONTROL_STOP:
+        server->stop_requested = 1;
+        break;
+    case CONTROL_CHECKPOINT:
+        if (!world_save_checkpoint(world, server->argument)) {
+            snprintf(reply, CONTROL_REPLY_MAX, "error: could not write %s", server->argument);
+        }
+        break;
+    case CONTROL_SET: {
+        char* value = strchr(server->argument, ' ');
+        *value++ = '\0';
+        while (*value == ' ') ++value;
+        WorldParams params = server->params;
+        EcologyParams ecology = server->ecology;
+        if (!set_param_value(server->argument, value, &params, &ecology)) {
+            snprintf(reply, CONTROL_REPLY_MAX, "error: unknown parameter or invalid value");
+        } else if (!world_set_params(world, &params) || !world_set_ecology(world, &ecology)) {
+            world_set_params(world, &server->params); // Leave both as they were
+            snprintf(reply, CONTROL_REPLY_MAX, "error: the world rejected the value");
+        } else {
+            server->params = params;
+            server->ecology = ecology;
+        }
+        break;
+    }
+    case CONTROL_NONE:
+        break;
+    }
+    server->status.paused = server->paused;
+}
+
+// Starts serving on path; returns 0 (after printing why) on failure
+int control_start(ControlServer* server, const char* path, const World* world) {
+    memset(server, 0, sizeof(*server));
+    server->listen_fd = -1;
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Control socket path %s is too long\n", path);
+        return 0;
+    }
+    snprintf(address.sun_path, sizeof(address.sun_path), "%s", path);
+    snprintf(server->path, sizeof(server->path), "%s", path);
+    server->listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (server->listen_fd < 0 || bind(server->listen_fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        fprintf(stderr, "Could not create control socket %s: %s%s\n", path, strerror(errno),
+                errno == EADDRINUSE ? " (if no run uses it, remove it)" : "");
+        if (server->listen_fd >= 0) close(server->listen_fd);
+        server->listen_fd = -1;
+        return 0;
+    }
+    // Only the user running the simulation may control it
+    if (chmod(path, 0600) != 0 || listen(server->listen_fd, CONTROL_MAX_CLIENTS) != 0) {
+        fprintf(stderr, "Could not listen on control socket %s\n", path);
+        close(server->listen_fd);
+        unlink(path);
+        server->listen_fd = -1;
+        return 0;
+    }
+    pthread_mutex_init(&server->lock, NULL);
+    server->params = *world_params(world);
+    server->ecology = *world_ecology(world);
+    server->start_ns = alife_now_ns();
+    control_publish(server, world);
+    if (pthread_create(&server->thread, NULL, serve, server) != 0) {
+        fprintf(stderr, "Could not start the control socket thread\n");
+        pthread_mutex_destroy(&server->lock);
+        close(server->listen_fd);
+        unlink(path);
+        server->listen_fd = -1;
+        return 0;
+    }
+    return 1;
+}
+
+// Publishes the world's state for status queries, unless the server thread is reading the last one
+void control_publish(ControlServer* server, const World* world) {
+    if (pthread_mutex_trylock(&server->lock) != 0) {
+        return;
+    }
+    ControlStatus* status = &server->status;
+    status->step = world_step_count(world);
+    status->life_forms = world_life_form_count(world);
+    status->food = world_food_count(world);
+    status->paused = server->paused;
+    status->kernels = world_kernel_name(world);
+    memcpy(status->phase_ns, world_phase_times_ns(world), sizeof(status->phase_ns));
+    status->elapsed_ns = alife_now_ns() - server->start_ns;
+    pthread_mutex_unlock(&server->lock);
+}
+
+// Executes a command posted by a client, if any and if the server thread is not busy with the lock
+void control_poll(ControlServer* server, World* world) {
+    if (pthread_mutex_trylock(&server->lock) != 0) {
+        return;
+    }
+    if (server->command != CONTROL_NONE && !server->replied) {
+        execute_command(server, world);
+        server->replied = 1;
+    }
+    pthread_mutex_unlock(&server->lock);
+}
+
+// Stops serving and removes the socket; pending commands are answered with an error
+void control_stop(ControlServer* server) {
+    if (server->listen_fd < 0) {
+        return;
+    }
+    pthread_mutex_lock(&server->lock);
+    server->stopping = 1;
+    pthread_mutex_unlock(&server->lock);
+    pthread_join(server->thread, NULL);
+    pthread_mutex_destroy(&server->lock);
+    close(server->listen_fd);
+    unlink(server->path);
+    server->listen_fd = -1;
+}
@@ -0,0 +1,67 @@
+#ifndef CONTROL_SOCKET_H
+#define CONTROL_SOCKET_H
+
+// Control socket of headless runs (--control PATH): a Unix-domain socket served by its own thread
+// that answers status queries and hands commands to the simulation thread. One request per line,
+// one reply per line:
+//   status                   {"step":...,"life_forms":...,...} (JSON)
+//   pause | resume | stop    ok
+//   checkpoint PATH          ok, or error: ...
+//   set NAME VALUE           ok, or error: ...; NAME as in a parameter file, applied at the next step
+// The simulation thread never waits for the server thread: it only try-locks the shared state, and
+// skips publishing or polling when the server holds it.
+
+#include <pthread.h>
+
+#include "alife.h"
+
+#define CONTROL_MAX_CLIENTS 8  // Connections served at once
+#define CONTROL_LINE_MAX 512   // Longest request line
+#define CONTROL_REPLY_MAX 1024 // Longest reply line
+
+// Commands executed by the simulation thread
+typedef enum {
+    CONTROL_NONE,
+    CONTROL_PAUSE,
+    CONTROL_RESUME,
+    CONTROL_STOP,
+    CONTROL_CHECKPOINT,
+    CONTROL_SET
+} ControlCommand;
+
+// The run state the server reports, as last published by the simulation thread
+typedef struct {
+    long long step;
+    int life_forms;
+    int food;
+    int paused;
+    const char* kernels;
+    double phase_ns[PHASE_COUNT]; // Accumulated since the run started
+    double elapsed_ns;            // Since the run started
+} ControlStatus;
+
+typedef struct {
+    char path[108];              // Socket path (sun_path)
+    int listen_fd;               // -1 when not serving
+    pthread_t thread;
+    double start_ns;
+    // Requests of the commands to the run loop; only the simulation thread uses these
+    int paused;
+    int stop_requested;
+    WorldParams params;          // Scheduled by set, applied by the world at its next step
+    EcologyParams ecology;
+    pthread_mutex_t lock;        // Guards everything below; the simulation thread only try-locks it
+    ControlStatus status;
+    ControlCommand command;      // Posted by the server thread
+    char argument[CONTROL_LINE_MAX];
+    int replied;                 // Set by the simulation thread once it has executed command into reply
+    char reply[CONTROL_REPLY_MAX];
+    int stopping;                // Set by control_stop
+} ControlServer;
+
+int control_start(ControlServer* server, const char* path, const World* world);
+void control_publish(ControlServer* server, const World* world);
+void control_poll(ControlServer* server, World* world);
+void control_stop(ControlServer* server);
+
+#endif // CONTROL_SOCKET_H
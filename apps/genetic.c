@@ -0,0 +1,310 @@
+#include <stdio.h>    // For the generation report and log (printf, fprintf)
+#include <stdlib.h>   // For malloc, free, qsort, strtod
+#include <string.h>   // For strchr, strncmp, memcpy
+#include <math.h>     // For sqrt, log, cos (Gaussian mutation)
+#include <pthread.h>  // For the evaluation threads
+#include <stdatomic.h> // For the shared evaluation counter
+
+#include "genetic.h"
+
+// Fills config with the defaults; the caller sets base and adds genes
+void ga_default_config(GaConfig* config) {
+    memset(config, 0, sizeof(*config));
+    config->population = GA_DEFAULT_POPULATION;
+    config->generations = GA_DEFAULT_GENERATIONS;
+    config->episodes = GA_DEFAULT_EPISODES;
+    config->episode_steps = GA_DEFAULT_EPISODE_STEPS;
+    config->elite = GA_DEFAULT_ELITE;
+    config->tournament = GA_DEFAULT_TOURNAMENT;
+    config->mutation_rate = GA_DEFAULT_MUTATION_RATE;
+    config->mutation_sigma = GA_DEFAULT_MUTATION_SIGMA;
+    config->jobs = 1;
+    world_default_config(&config->base);
+}
+
+// Parses NAME:MIN:MAX, NAME as in a parameter file; returns 0 (after printing why) if invalid
+int parse_gene(const char* spec, Gene* gene) {
+    const char* colon = strchr(spec, ':');
+    gene->param = NULL;
+    for (int i = 0; colon != NULL && i < tunable_param_count; ++i) {
+        if (strncmp(tunable_params[i].name, spec, colon - spec) == 0 && tunable_params[i].name[colon - spec] == '\0') {
+            gene->param = &tunable_params[i];
+        }
+    }
+    char* end = NULL;
+    if (gene->param != NULL) {
+        gene->min = strtod(colon + 1, &end);
+    }
+    if (end != NULL && *end == ':') {
+        gene->max = strtod(end + 1, &end);
+    }
+    if (gene->param == NULL || end == NULL || *end != '\0' || !(gene->min < gene->max)) {
+        fprintf(stderr, "--gene expects NAME:MIN:MAX with a parameter name and MIN < MAX, e.g. sense-radius:20:400\n");
+        return 0;
+    }
+    return 1;
+}
+
+// Sets the parameters the genome's genes name
+void apply_genome(const GaConfig* config, const Genome* genome, WorldParams* params, EcologyParams* ecology) {
+    for (int g = 0; g < config->gene_count; ++g) {
+        *tunable_value(config->genes[g].param, params, ecology) = genome->values[g];
+    }
+}
+
+// Prints the genes of genome as NAME=VALUE
+static void print_genes(FILE* out, const GaConfig* config, const Genome* genome) {
+    for (int g = 0; g < config->gene_count; ++g) {
+        fprintf(out, "%s%s=%.6g", g > 0 ? " " : "", config->genes[g].param->name, genome->values[g]);
+    }
+}
+
+// --- Random Numbers ---
+// The GA's own generator (xorshift64*, as the worlds'), so that evolution is reproducible from the seed
+
+static unsigned long long ga_rng_state;
+
+static double ga_random_unit() {
+    ga_rng_state ^= ga_rng_state >> 12;
+    ga_rng_state ^= ga_rng_state << 25;
+    ga_rng_state ^= ga_rng_state >> 27;
+    return (double)((ga_rng_state * 0x2545F4914F6CDD1DULL) >> 11) / 9007199254740992.0; // [0, 1)
+}
+
+// Standard normal deviate (Box-Muller)
+static double ga_random_normal() {
+    double u = 1.0 - ga_random_unit(); // (0, 1]
+    return sqrt(-2.0 * log(u)) * cos(2.0 * 3.14159265358979323846 * ga_random_unit());
+}
+
+// --- Evaluation ---
+// Every (genome, episode) pair is one task; threads take tasks from a shared counter. Episode e of
+// a generation uses the same seed for every genome, so genomes are compared on the same worlds.
+
+typedef struct {
+    const GaConfig* config;
+    Genome* genomes;
+    double* scores;          // Per task
+    int* valid;              // Per genome: whether the world accepts its parameters
+    atomic_int next_task;
+    int task_count;
+    unsigned long long seed; // Of the generation's first episode
+} Evaluation;
+
+typedef struct {
+    Evaluation* evaluation;
+    World* world;
+    pthread_t thread;
+} Evaluator;
+
+// Runs one episode of genome in world; returns its fitness: the mean population over its steps,
+// counting at most max_life_forms - 1 per step, so steps after extinction count 0. A full array
+// blocks reproduction rather than reflecting the ecology, so it scores no better than one life
+// form short of it, and the score still rises steadily with the population up to there.
+static double run_episode(const GaConfig* config, const Genome* genome, World* world, unsigned long long seed) {
+    WorldConfig episode = config->base;
+    episode.seed = seed;
+    apply_genome(config, genome, &episode.params, &episode.ecology);
+    if (!world_reset(world, &episode)) {
+        return 0.0; // Checked by evaluate already; the worst fitness
+    }
+    int cap = config->base.max_life_forms - 1;
+    double population_sum = 0.0;
+    for (long long step = 0; step < config->episode_steps && world_life_form_count(world) > 0; ++step) {
+        world_step(world);
+        int population = world_life_form_count(world);
+        population_sum += population < cap ? population : cap;
+    }
+    return population_sum / config->episode_steps;
+}
+
+static void* evaluate_tasks(void* arg) {
+    Evaluator* evaluator = (Evaluator*)arg;
+    Evaluation* evaluation = evaluator->evaluation;
+    const GaConfig* config = evaluation->config;
+    int task;
+    while ((task = atomic_fetch_add(&evaluation->next_task, 1)) < evaluation->task_count) {
+        int episode = task % config->episodes;
+        int genome = task / config->episodes;
+        evaluation->scores[task] = !evaluation->valid[genome] ? 0.0
+            : run_episode(config, &evaluation->genomes[genome], evaluator->world, evaluation->seed + episode);
+    }
+    return NULL;
+}
+
+// Sets the fitness of every genome, evaluating on all evaluators. Genomes whose parameters a world
+// would reject are reported once here, by their genes, and score 0 without running.
+static void evaluate(Evaluation* evaluation, Evaluator* evaluators, int jobs) {
+    const GaConfig* config = evaluation->config;
+    for (int i = 0; i < config->population; ++i) {
+        WorldParams params = config->base.params;
+        EcologyParams ecology = config->base.ecology;
+        apply_genome(config, &evaluation->genomes[i], &params, &ecology);
+        fflush(stdout);
+        evaluation->valid[i] = world_check_params(&params, &ecology);
+        if (!evaluation->valid[i]) {
+            fprintf(stderr, "  rejected genome ");
+            print_genes(stderr, config, &evaluation->genomes[i]);
+            fprintf(stderr, " (fitness 0)\n");
+        }
+    }
+    atomic_store(&evaluation->next_task, 0);
+    int started = 1;
+    for (; started < jobs; ++started) {
+        if (pthread_create(&evaluators[started].thread, NULL, evaluate_tasks, &evaluators[started]) != 0) {
+            break; // The threads already started and this one take all tasks anyway
+        }
+    }
+    evaluate_tasks(&evaluators[0]);
+    for (int i = 1; i < started; ++i) {
+        pthread_join(evaluators[i].thread, NULL);
+    }
+    for (int i = 0; i < config->population; ++i) {
+        double sum = 0.0;
+        for (int e = 0; e < config->episodes; ++e) {
+            sum += evaluation->scores[i * config->episodes + e];
+        }
+        evaluation->genomes[i].fitness = sum / config->episodes;
+    }
+}
+
+// --- Reproduction ---
+
+static int by_fitness_descending(const void* a, const void* b) {
+    double fa = ((const Genome*)a)->fitness;
+    double fb = ((const Genome*)b)->fitness;
+    return (fa < fb) - (fa > fb);
+}
+
+// Returns the fittest of config->tournament randomly drawn genomes
+static const Genome* select_parent(const GaConfig* config, const Genome* genomes) {
+    const Genome* best = &genomes[(int)(ga_random_unit() * config->population)];
+    for (int i = 1; i < config->tournament; ++i) {
+        const Genome* candidate = &genomes[(int)(ga_random_unit() * config->population)];
+        if (candidate->fitness > best->fitness) {
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+// Fills next from the sorted genomes: the elite unchanged, the rest by tournament selection,
+// uniform crossover and Gaussian mutation within each gene's range
+static void breed(const GaConfig* config, const Genome* genomes, Genome* next) {
+    for (int i = 0; i < config->population; ++i) {
+        if (i < config->elite) {
+            next[i] = genomes[i];
+            continue;
+        }
+        const Genome* a = select_parent(config, genomes);
+        const Genome* b = select_parent(config, genomes);
+        for (int g = 0; g < config->gene_count; ++g) {
+            const Gene* gene = &config->genes[g];
+            double value = ga_random_unit() < 0.5 ? a->values[g] : b->values[g];
+            if (ga_random_unit() < config->mutation_rate) {
+                value += ga_random_normal() * config->mutation_sigma * (gene->max - gene->min);
+            }
+            next[i].values[g] = value < gene->min ? gene->min : value > gene->max ? gene->max : value;
+        }
+    }
+}
+
+// --- Driver ---
+
+// Evolves config->population genomes for config->generations generations, printing every
+// generation and logging it to log as CSV if not NULL; returns 0 (after printing why) on failure,
+// otherwise 1 with the fittest genome of the last generation in best
+int run_ga(const GaConfig* config, FILE* log, Genome* best) {
+    if (config->gene_count < 1 || config->population < 2 || config->generations < 1 || config->episodes < 1
+        || config->episode_steps < 1 || config->elite < 0 || config->elite >= config->population
+        || config->tournament < 1 || config->mutation_rate < 0 || config->mutation_sigma < 0 || config->jobs < 1) {
+        fprintf(stderr, "The GA needs a gene, a population of at least 2 with fewer elite, and positive counts\n");
+        return 0;
+    }
+    int jobs = config->jobs < config->population * config->episodes ? config->jobs : config->population * config->episodes;
+    Genome* genomes = (Genome*)malloc(config->population * sizeof(Genome));
+    Genome* next = (Genome*)malloc(config->population * sizeof(Genome));
+    Evaluation evaluation;
+    evaluation.config = config;
+    evaluation.task_count = config->population * config->episodes;
+    evaluation.scores = (double*)malloc(evaluation.task_count * sizeof(double));
+    evaluation.valid = (int*)malloc(config->population * sizeof(int));
+    Evaluator* evaluators = (Evaluator*)calloc(jobs, sizeof(Evaluator));
+    int ok = genomes != NULL && next != NULL && evaluation.scores != NULL && evaluation.valid != NULL
+             && evaluators != NULL;
+    // Worlds are allocated once, here, and reset for every episode
+    for (int i = 0; ok && i < jobs; ++i) {
+        evaluators[i].evaluation = &evaluation;
+        evaluators[i].world = world_create(&config->base);
+        ok = evaluators[i].world != NULL;
+    }
+    if (!ok) {
+        fprintf(stderr, "Could not set up the GA evaluations\n");
+    }
+
+    if (ok) {
+        unsigned long long z = config->base.seed + 0x9E3779B97F4A7C15ULL; // splitmix64, as seed_random
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        ga_rng_state = (z ^ (z >> 31)) | 1;
+        for (int i = 0; i < config->population; ++i) {
+            for (int g = 0; g < config->gene_count; ++g) {
+                const Gene* gene = &config->genes[g];
+                genomes[i].values[g] = gene->min + ga_random_unit() * (gene->max - gene->min);
+            }
+        }
+        if (log != NULL) {
+            fprintf(log, "generation,best_fitness,mean_fitness,worst_fitness");
+            for (int g = 0; g < config->gene_count; ++g) {
+                fprintf(log, ",best_%s", config->genes[g].param->name);
+            }
+            fprintf(log, "\n");
+        }
+    }
+    for (int generation = 0; ok && generation < config->generations; ++generation) {
+        double start_ns = alife_now_ns();
+        evaluation.genomes = genomes;
+        evaluation.seed = config->base.seed + (unsigned long long)generation * config->episodes;
+        evaluate(&evaluation, evaluators, jobs);
+        qsort(genomes, config->population, sizeof(Genome), by_fitness_descending);
+        double mean = 0.0;
+        for (int i = 0; i < config->population; ++i) {
+            mean += genomes[i].fitness / config->population;
+        }
+        double seconds = (alife_now_ns() - start_ns) * 1e-9;
+        printf("Generation %d: best %.2f, mean %.2f, worst %.2f (%.1f episodes/s): ", generation, genomes[0].fitness,
+               mean, genomes[config->population - 1].fitness, seconds > 0 ? evaluation.task_count / seconds : 0.0);
+        print_genes(stdout, config, &genomes[0]);
+        printf("\n");
+        if (generation == 0 && genomes[0].fitness == genomes[config->population - 1].fitness) {
+            printf("Note: every genome scored the same; the genes may not matter in this scenario\n");
+        }
+        fflush(stdout);
+        if (log != NULL) {
+            fprintf(log, "%d,%.6f,%.6f,%.6f", generation, genomes[0].fitness, mean,
+                    genomes[config->population - 1].fitness);
+            for (int g = 0; g < config->gene_count; ++g) {
+                fprintf(log, ",%.17g", genomes[0].values[g]);
+            }
+            fprintf(log, "\n");
+            fflush(log);
+        }
+        *best = genomes[0];
+        if (generation + 1 < config->generations) {
+            breed(config, genomes, next);
+            Genome* swap = genomes;
+            genomes = next;
+            next = swap;
+        }
+    }
+
+    for (int i = 0; evaluators != NULL && i < jobs; ++i) {
+        world_destroy(evaluators[i].world);
+    }
+    free(evaluators);
+    free(evaluation.scores);
+    free(evaluation.valid);
+    free(next);
+    free(genomes);
+    return ok;
+}
@@ -0,0 +1,57 @@
+#ifndef GENETIC_H
+#define GENETIC_H
+
+// Generational genetic algorithm over world parameters (--ga): every genome is a set of parameter
+// values, evaluated by running short headless episodes in parallel. Each evaluation thread owns one
+// world, allocated once and reset in place (world_reset) for every episode.
+
+#include <stdio.h> // For FILE (the generation log)
+
+#include "alife.h"
+#include "param_file.h"
+
+#define GA_MAX_GENES 16
+
+// --- GA Parameters ---
+#define GA_DEFAULT_POPULATION 32
+#define GA_DEFAULT_GENERATIONS 20
+#define GA_DEFAULT_EPISODES 2          // Episodes per evaluation, with different seeds
+#define GA_DEFAULT_EPISODE_STEPS 2000
+#define GA_DEFAULT_ELITE 2             // Best genomes copied unchanged into the next generation
+#define GA_DEFAULT_TOURNAMENT 3        // Genomes competing for each parent slot
+#define GA_DEFAULT_MUTATION_RATE 0.2   // Chance that a gene mutates
+#define GA_DEFAULT_MUTATION_SIGMA 0.1  // Standard deviation of a mutation, relative to the gene's range
+
+// A parameter the GA evolves, within [min, max]
+typedef struct {
+    const TunableParam* param;
+    double min;
+    double max;
+} Gene;
+
+typedef struct {
+    Gene genes[GA_MAX_GENES];
+    int gene_count;
+    int population;
+    int generations;
+    int episodes;
+    long long episode_steps;
+    int elite;
+    int tournament;
+    double mutation_rate;
+    double mutation_sigma;
+    int jobs;                // Evaluation threads, each with its own world
+    WorldConfig base;        // World of every episode; the genes override its params and ecology
+} GaConfig;
+
+typedef struct {
+    double values[GA_MAX_GENES];
+    double fitness;          // Mean population over the episodes' steps, capped one below capacity
+} Genome;
+
+void ga_default_config(GaConfig* config);
+int parse_gene(const char* spec, Gene* gene);
+void apply_genome(const GaConfig* config, const Genome* genome, WorldParams* params, EcologyParams* ecology);
+int run_ga(const GaConfig* config, FILE* log, Genome* best);
+
+#endif // GENETIC_H
@@ -0,0 +1,196 @@
+#include <stdio.h>       // For parameter files (fopen, fgets, fprintf)
+#include <stdlib.h>      // For strtod
+#include <string.h>      // For strcmp, strchr, strrchr
+#include <unistd.h>      // For read, close
+#include <sys/inotify.h> // For watching the parameter file
+
+#include "param_file.h"
+
+const TunableParam tunable_params[] = {
+    { "width", 0, offsetof(WorldParams, width), 50.0 },
+    { "height", 0, offsetof(WorldParams, height), 50.0 },
+    { "life-form-radius", 0, offsetof(WorldParams, life_form_radius), 1.0 },
+    { "food-radius", 0, offsetof(WorldParams, food_radius), 1.0 },
+    { "sense-radius", 0, offsetof(WorldParams, sense_radius), 10.0 },
+    { "reproduction-threshold", 1, offsetof(EcologyParams, reproduction_threshold), 5.0 },
+    { "energy-loss", 1, offsetof(EcologyParams, energy_loss), 0.01 },
+    { "energy-gain", 1, offsetof(EcologyParams, energy_gain), 1.0 },
+    { "mutation-width", 1, offsetof(EcologyParams, mutation_width), 0.05 },
+    { "min-speed-factor", 1, offsetof(EcologyParams, min_speed_factor), 0.05 },
+    { "max-speed-factor", 1, offsetof(EcologyParams, max_speed_factor), 0.1 },
+    { "food-respawn", 1, offsetof(EcologyParams, food_respawn_chance), 0.05 },
+    { "field-regrowth", 1, offsetof(EcologyParams, field_regrowth), 0.00001 },
+    { "field-diffusion", 1, offsetof(EcologyParams, field_diffusion), 0.01 },
+    { "field-graze", 1, offsetof(EcologyParams, field_graze), 0.005 },
+    { "scent1-deposit", 1, offsetof(EcologyParams, scent[0].deposit), 0.1 },
+    { "scent1-decay", 1, offsetof(EcologyParams, scent[0].decay), 0.005 },
+    { "scent1-diffusion", 1, offsetof(EcologyParams, scent[0].diffusion), 0.01 },
+    { "scent1-attraction", 1, offsetof(EcologyParams, scent[0].attraction), 0.05 },
+    { "scent2-deposit", 1, offsetof(EcologyParams, scent[1].deposit), 0.1 },
+    { "scent2-decay", 1, offsetof(EcologyParams, scent[1].decay), 0.005 },
+    { "scent2-diffusion", 1, offsetof(EcologyParams, scent[1].diffusion), 0.01 },
+    { "scent2-attraction", 1, offsetof(EcologyParams, scent[1].attraction), 0.05 },
+};
+const int tunable_param_count = sizeof(tunable_params) / sizeof(tunable_params[0]);
+
+// Returns the field of params or ecology that param names
+double* tunable_value(const TunableParam* param, WorldParams* params, EcologyParams* ecology) {
+    char* base = param->ecology ? (char*)ecology : (char*)params;
+    return (double*)(base + param->offset);
+}
+
+// Sets the parameter called name (as in a parameter file) to value, given as text; returns 0 if
+// either is invalid. The world checks the resulting parameters as a whole.
+int set_param_value(const char* name, const char* value, WorldParams* params, EcologyParams* ecology) {
+    if (strcmp(name, "boundary") == 0) {
+        int policy = parse_boundary_policy(value);
+        if (policy >= 0) params->boundary = (BoundaryPolicy)policy;
+        return policy >= 0;
+    }
+    if (strcmp(name, "sensing") == 0) {
+        int mode = parse_sensing_mode(value);
+        if (mode >= 0) params->sensing = (SensingMode)mode;
+        return mode >= 0;
+    }
+    int i = 0;
+    while (i < tunable_param_count && strcmp(tunable_params[i].name, name) != 0) ++i;
+    char* end = (char*)value;
+    double number = strtod(value, &end);
+    if (i == tunable_param_count || end == value || *end != '\0') {
+        return 0;
+    }
+    *tunable_value(&tunable_params[i], params, ecology) = number;
+    return 1;
+}
+
+// Removes leading and trailing whitespace in place
+static char* trim(char* s) {
+    while (*s == ' ' || *s == '\t') ++s;
+    char* end = s + strlen(s);
+    while (end > s && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\n' || end[-1] == '\r')) --end;
+    *end = '\0';
+    return s;
+}
+
+// --- Parameter Files ---
+// One "name = value" per line; "#" starts a comment. Names are the world and ecology options
+// without "--", plus boundary (bounce or wrap) and sensing (global or local). Parameters the file
+// does not name keep their values.
+
+// Reads path into params and ecology; returns 0 (after printing why, leaving both unchanged) if the
+// file cannot be read or has an invalid line
+int load_param_file(const char* path, WorldParams* params, EcologyParams* ecology) {
+    FILE* f = fopen(path, "r");
+    if (f == NULL) {
+        fprintf(stderr, "Could not open parameter file %s\n", path);
+        return 0;
+    }
+    WorldParams new_params = *params;
+    EcologyParams new_ecology = *ecology;
+    char line[256];
+    int line_number = 0;
+    int ok = 1;
+    while (ok && fgets(line, sizeof(line), f) != NULL) {
+        ++line_number;
+        char* comment = strchr(line, '#');
+        if (comment != NULL) *comment = '\0';
+        char* text = trim(line);
+        if (*text == '\0') {
+            continue;
+        }
+        char* equals = strchr(text, '=');
+        ok = equals != NULL;
+        if (ok) {
+            *equals = '\0';
+            ok = set_param_value(trim(text), trim(equals + 1), &new_params, &new_ecology);
+        }
+        if (!ok) {
+            fprintf(stderr, "%s:%d: expected NAME = VALUE with a known parameter name and a valid value\n", path,
+                    line_number);
+        }
+    }
+    fclose(f);
+    if (ok) {
+        *params = new_params;
+        *ecology = new_ecology;
+    }
+    return ok;
+}
+
+// Writes every parameter to path in the format load_param_file reads; returns 0 on failure
+int save_param_file(const char* path, const WorldParams* params, const EcologyParams* ecology) {
+    FILE* f = fopen(path, "w");
+    if (f == NULL) {
+        fprintf(stderr, "Could not write parameter file %s\n", path);
+        return 0;
+    }
+    WorldParams p = *params;
+    EcologyParams e = *ecology;
+    for (int i = 0; i < tunable_param_count; ++i) {
+        // The shortest of %.15g and %.17g that reads back as the same value
+        double value = *tunable_value(&tunable_params[i], &p, &e);
+        char text[32];
+        snprintf(text, sizeof(text), "%.15g", value);
+        if (strtod(text, NULL) != value) {
+            snprintf(text, sizeof(text), "%.17g", value);
+        }
+        fprintf(f, "%s = %s\n", tunable_params[i].name, text);
+    }
+    fprintf(f, "boundary = %s\n", boundary_policy_name(params->boundary));
+    fprintf(f, "sensing = %s\n", sensing_mode_name(params->sensing));
+    int ok = !ferror(f);
+    if (fclose(f) != 0 || !ok) {
+        fprintf(stderr, "Could not write parameter file %s\n", path);
+        return 0;
+    }
+    return 1;
+}
+
+// --- Watching ---
+// The watch is on the file's directory, not the file: editors often save by writing a new file
+// and renaming it over the old one, which a watch on the old file would not see.
+
+// Starts watching path; returns 0 (after printing why) on failure
+int param_watch_start(ParamWatch* watch, const char* path) {
+    char dir[4096];
+    const char* slash = strrchr(path, '/');
+    if (slash == NULL) {
+        snprintf(dir, sizeof(dir), ".");
+        snprintf(watch->name, sizeof(watch->name), "%s", path);
+    } else {
+        snprintf(dir, sizeof(dir), "%.*s", slash == path ? 1 : (int)(slash - path), path);
+        snprintf(watch->name, sizeof(watch->name), "%s", slash + 1);
+    }
+    watch->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watch->fd < 0 || inotify_add_watch(watch->fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        fprintf(stderr, "Could not watch %s for changes\n", path);
+        param_watch_stop(watch);
+        return 0;
+    }
+    return 1;
+}
+
+// Returns 1 if the file was written or replaced since the last poll; never blocks
+int param_watch_poll(ParamWatch* watch) {
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    int changed = 0;
+    ssize_t length;
+    while (watch->fd >= 0 && (length = read(watch->fd, buffer, sizeof(buffer))) > 0) {
+        for (char* p = buffer; p < buffer + length;) {
+            const struct inotify_event* event = (const struct inotify_event*)p;
+            if (event->len > 0 && strcmp(event->name, watch->name) == 0) {
+                changed = 1;
+            }
+            p += sizeof(struct inotify_event) + event->len;
+        }
+    }
+    return changed;
+}
+
+// Stops watching
+void param_watch_stop(ParamWatch* watch) {
+    if (watch->fd >= 0) {
+        close(watch->fd);
+    }
+    watch->fd = -1;
+}
@@ -0,0 +1,36 @@
+#ifndef PARAM_FILE_H
+#define PARAM_FILE_H
+
+// Parameter files: world parameters and ecology as "name = value" lines, read at startup
+// (--params) and reloaded by the interactive frontend whenever the file changes (inotify)
+
+#include <stddef.h> // For size_t
+
+#include "alife.h"
+
+// A numeric parameter that parameter files and the interactive panel can set
+typedef struct {
+    const char* name; // Key in a parameter file: the command-line option without "--"
+    int ecology;      // 1 = field of EcologyParams, 0 = field of WorldParams
+    size_t offset;    // Of the double field
+    double step;      // Panel increment
+} TunableParam;
+
+extern const TunableParam tunable_params[];
+extern const int tunable_param_count;
+
+// Watches one file for being rewritten or replaced
+typedef struct {
+    int fd;           // inotify descriptor, -1 when not watching
+    char name[256];   // File name within the watched directory
+} ParamWatch;
+
+double* tunable_value(const TunableParam* param, WorldParams* params, EcologyParams* ecology);
+int set_param_value(const char* name, const char* value, WorldParams* params, EcologyParams* ecology);
+int load_param_file(const char* path, WorldParams* params, EcologyParams* ecology);
+int save_param_file(const char* path, const WorldParams* params, const EcologyParams* ecology);
+int param_watch_start(ParamWatch* watch, const char* path);
+int param_watch_poll(ParamWatch* watch);
+void param_watch_stop(ParamWatch* watch);
+
+#endif // PARAM_FILE_H
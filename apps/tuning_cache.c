@@ -0,0 +1,132 @@
+#include <stdio.h>    // For the cache file (fopen, fgets, fprintf) and the report
+#include <string.h>   // For strncmp, strchr, strlen
+#include <unistd.h>   // For sysconf (number of CPUs)
+
+#include "tuning_cache.h"
+
+// Hashes a string (FNV-1a, 64 bits)
+static unsigned long long hash_text(const char* text) {
+    unsigned long long hash = 0xcbf29ce484222325ULL;
+    for (const unsigned char* c = (const unsigned char*)text; *c != '\0'; ++c) {
+        hash = (hash ^ *c) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// Returns the number of bits of n: the same for counts within a factor of two of each other
+static int count_bucket(int n) {
+    int bits = 0;
+    while (n > 0) {
+        n >>= 1;
+        bits++;
+    }
+    return bits;
+}
+
+// Fingerprint of the machine: the CPU model (from /proc/cpuinfo where there is one) and CPU count
+unsigned long long hardware_fingerprint() {
+    char model[256] = "unknown";
+    FILE* cpuinfo = fopen("/proc/cpuinfo", "r");
+    if (cpuinfo != NULL) {
+        char line[256];
+        while (fgets(line, sizeof(line), cpuinfo) != NULL) {
+            char* colon = strchr(line, ':');
+            if (colon != NULL && strncmp(line, "model name", 10) == 0) {
+                snprintf(model, sizeof(model), "%s", colon + 1);
+                break;
+            }
+        }
+        fclose(cpuinfo);
+    }
+    char text[320];
+    snprintf(text, sizeof(text), "%s|%ld", model, sysconf(_SC_NPROCESSORS_ONLN));
+    return hash_text(text);
+}
+
+// Fingerprint of what a world costs to step: everything the best configuration depends on.
+// The engine, food model, scent fields and grid size decide which phases run and which of them
+// run on the pool, so a choice made for one of them says nothing about another.
+unsigned long long scenario_fingerprint(const World* world, int max_threads) {
+    const WorldParams* params = world_params(world);
+    int columns, rows;
+    world_field_size(world, &columns, &rows);
+    if (columns == 0 && world_scent_fields(world) > 0) {
+        world_scent(world, 0, &columns, &rows); // Point food: the grid is the scent's
+    }
+    char text[512];
+    snprintf(text, sizeof(text), "%d|%d|%.17g|%.17g|%.17g|%.17g|%.17g|%d|%d|%d|%d|%d|%s|%s|%s|%d|%dx%d",
+             world_max_life_forms(world), world_max_food_sources(world), params->width, params->height,
+             params->life_form_radius, params->food_radius, params->sense_radius, (int)params->boundary,
+             (int)params->sensing, count_bucket(world_life_form_count(world)), count_bucket(world_food_count(world)),
+             max_threads, world_kernel_name(world), engine_name(world_engine(world)),
+             food_model_name(world_food_model(world)), world_scent_fields(world), columns, rows);
+    return hash_text(text);
+}
+
+// Looks up the newest entry for the fingerprints in the cache file; returns 1 if there is one
+static int find_cached(const char* path, unsigned long long hardware, unsigned long long scenario,
+                       TuningResult* tuning) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        return 0;
+    }
+    int found = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), file) != NULL) {
+        unsigned long long h, s;
+        TuningResult entry;
+        if (line[0] != '#' && sscanf(line, "%llx %llx %d %d %d %lf", &h, &s, &entry.threads, &entry.chunk_size,
+                                     &entry.specialized, &entry.ns_per_step) == 6
+            && h == hardware && s == scenario) {
+            entry.candidates = 0;
+            *tuning = entry;
+            found = 1;
+        }
+    }
+    fclose(file);
+    return found;
+}
+
+// Appends an entry to the cache file, starting it with a header if it is new; returns 0 on failure
+static int store_cached(const char* path, unsigned long long hardware, unsigned long long scenario,
+                        const TuningResult* tuning) {
+    FILE* file = fopen(path, "a");
+    if (file == NULL) {
+        return 0;
+    }
+    if (ftell(file) == 0) {
+        fprintf(file, "# alife tuning cache: hardware scenario threads chunk_size specialized ns_per_step\n");
+    }
+    fprintf(file, "%016llx %016llx %d %d %d %.0f\n", hardware, scenario, tuning->threads, tuning->chunk_size,
+            tuning->specialized, tuning->ns_per_step);
+    return fclose(file) == 0;
+}
+
+// Gives world the cached configuration for this machine and scenario, or tunes it on its current
+// state (up to max_threads threads) and caches the result; prints the choice. Returns 0 (after
+// printing why) on failure; a cache that cannot be read or written only costs the tuning.
+int autotune_world(World* world, const char* cache_path, int max_threads) {
+    unsigned long long hardware = hardware_fingerprint();
+    unsigned long long scenario = scenario_fingerprint(world, max_threads);
+    TuningResult tuning;
+    const char* source = "cached";
+    if (cache_path == NULL || !find_cached(cache_path, hardware, scenario, &tuning)) {
+        if (!world_autotune(world, max_threads, DEFAULT_TUNING_STEPS, &tuning)) {
+            return 0;
+        }
+        source = "measured";
+        if (cache_path != NULL && !store_cached(cache_path, hardware, scenario, &tuning)) {
+            fprintf(stderr, "Could not write the tuning cache %s\n", cache_path);
+        }
+    } else if (!world_apply_tuning(world, &tuning)) {
+        return 0;
+    }
+    printf("Tuned: %d thread%s, chunks of %d, %s kernels, %.1f us/step (%s", tuning.threads,
+           tuning.threads == 1 ? "" : "s", tuning.chunk_size, world_kernel_name(world), tuning.ns_per_step * 1e-3,
+           source);
+    if (tuning.candidates > 0) {
+        printf(", %d candidates", tuning.candidates);
+    }
+    printf(")\n");
+    return 1;
+}
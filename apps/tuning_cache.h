@@ -0,0 +1,20 @@
+#ifndef TUNING_CACHE_H
+#define TUNING_CACHE_H
+
+// Auto-tuning at startup (--autotune): the threading and kernels world_autotune chooses are cached
+// in a text file per hardware and scenario fingerprint, so later runs of the same scenario on the
+// same machine start with them at once. One line per entry, the newest entry of a key winning:
+//   HARDWARE SCENARIO THREADS CHUNK_SIZE SPECIALIZED NS_PER_STEP
+// HARDWARE hashes the CPU model and count; SCENARIO hashes the capacities, world parameters,
+// population and food (to the nearest power of two), the thread limit and whether kernels may be
+// specialized.
+
+#include "alife.h"
+
+#define TUNING_DEFAULT_CACHE "alife-tuning.cache"
+
+unsigned long long hardware_fingerprint();
+unsigned long long scenario_fingerprint(const World* world, int max_threads);
+int autotune_world(World* world, const char* cache_path, int max_threads);
+
+#endif // TUNING_CACHE_H
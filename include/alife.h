@@ -0,0 +1,458 @@
+#ifndef ALIFE_H
+#define ALIFE_H
+
+// libalife: the artificial life simulation core.
+// A World holds everything one simulation needs (entities, random generator, worker threads), so
+// several worlds can exist side by side. The library has no SDL dependency; frontends read the
+// state through the accessors below and draw it however they like.
+
+#include <stdio.h> // For FILE (reports)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// --- Simulation Parameters ---
+#define INITIAL_LIFE_FORMS 10
+#define INITIAL_FOOD_SOURCES 50
+#define MAX_LIFE_FORMS 200 // Maximum number of life forms to prevent excessive growth
+#define MAX_FOOD_SOURCES 100 // Maximum number of food sources
+
+// Default world dimensions in simulation units (WorldParams overrides them per world)
+#define WORLD_WIDTH 800
+#define WORLD_HEIGHT 600
+
+#define LIFE_FORM_RADIUS 8.0 // Conceptual radius for collision detection
+#define FOOD_RADIUS 3.0      // Conceptual radius for collision detection
+#define SENSE_RADIUS 150.0   // How far life forms see food with SENSE_LOCAL
+
+#define MAX_ENERGY 100.0
+
+// Default ecology (EcologyParams overrides it per world)
+#define REPRODUCTION_THRESHOLD 80.0
+#define ENERGY_LOSS_PER_STEP 0.05 // Slower for smoother animation
+#define ENERGY_GAIN_FROM_FOOD 20.0
+#define MUTATION_WIDTH 0.4        // Offspring speed factor = parent's + uniform(-width/2, width/2)...
+#define MIN_SPEED_FACTOR 0.5      // ...clamped to [MIN_SPEED_FACTOR, MAX_SPEED_FACTOR]
+#define MAX_SPEED_FACTOR 2.0
+#define FOOD_RESPAWN_CHANCE 0.8   // Chance that eaten food respawns somewhere else
+#define FIELD_REGROWTH 0.00005    // Share of its missing density a food field cell regrows per step
+#define FIELD_DIFFUSION 0.1       // Share of the density difference to each neighbouring cell exchanged per step
+#define FIELD_GRAZE 0.02          // Density a life form eats from its cell per step
+#define SCENT_DEPOSIT 1.0         // Scent a life form leaves in its cell per step
+#define SCENT_DECAY 0.05          // Share of its scent a cell loses per step
+#define SCENT_DIFFUSION 0.1       // As FIELD_DIFFUSION, for scent
+#define SCENT_ATTRACTION 0.5      // Velocity change per unit of scent gradient; negative to avoid scent
+
+// --- Food Field Parameters ---
+#define FIELD_CELL_SIZE 10.0 // Default edge of a food field cell in simulation units
+#define MAX_FIELD_CELLS 4096 // Most columns or rows of a food field
+#define MAX_SCENT_FIELDS 2   // Scent fields a world can have, on the food field's grid
+
+// --- Rewind Parameters ---
+#define DEFAULT_KEYFRAME_INTERVAL 64 // Steps between full states in the rewind buffer
+
+// --- Island Parameters ---
+#define DEFAULT_ISLANDS 4              // Worlds of an archipelago
+#define DEFAULT_MIGRATION_INTERVAL 100 // Steps between migrations
+#define DEFAULT_MIGRANTS 2             // Life forms each island sends per migration
+
+// --- Threading Parameters ---
+#define MAX_THREADS 256         // Upper bound for WorldConfig.threads
+#define DEFAULT_CHUNK_SIZE 64   // Life forms per work item handed to a worker thread
+
+// --- Tuning Parameters ---
+#define DEFAULT_TUNING_STEPS 20 // Steps world_autotune times each candidate configuration for
+
+// --- Struct Definitions ---
+
+// Represents a single artificial life form. Energy is stored lazily: energy is its value when the
+// world's step count was energy_step, and every step since has cost energy_loss (clamped to
+// [0, MAX_ENERGY]); read the current value with world_life_form_energy.
+typedef struct {
+    double x, y;        // Position in simulation units
+    double vx, vy;      // Velocity in simulation units per step
+    double energy;      // Energy level at energy_step
+    double speed_factor; // Genetic trait: affects movement speed
+    long long energy_step; // Step count energy was stored at (from a step's update phase on: step + 1)
+    long long death_step;  // Step count at which energy runs out unless the life form feeds first
+    int id;             // Unique identifier for the life form
+    unsigned char r, g, b; // Color
+} LifeForm;
+
+// Represents a food source in the environment
+typedef struct {
+    double x, y;        // Position in simulation units
+    int is_present;     // Flag to check if food exists
+} Food;
+
+// Simulation phases, timed separately by every step
+typedef enum {
+    PHASE_UPDATE,    // update_life_form for every life form
+    PHASE_INTERACT,  // handle_interactions (feeding and food respawn)
+    PHASE_REPRODUCE, // Reproduction, death and array compaction
+    PHASE_COUNT
+} SimPhase;
+
+// How worker threads are placed on CPUs
+typedef enum {
+    PIN_NONE,    // Leave placement to the OS scheduler
+    PIN_COMPACT, // Thread i on CPU i: fill neighbouring CPUs first
+    PIN_SCATTER, // Spread threads evenly over all CPUs
+    PIN_STRATEGY_COUNT
+} PinStrategy;
+
+// How world_set_validation compares the optimized phase kernels with the reference ones
+typedef enum {
+    VALIDATE_OFF,
+    VALIDATE_EXACT,     // Every value must be bit-identical
+    VALIDATE_TOLERANCE  // Floating-point values may differ by a relative tolerance
+} ValidationMode;
+
+// What happens to a life form that reaches the edge of the world
+typedef enum {
+    BOUNDARY_BOUNCE, // Reflect off the walls, keeping the whole body inside
+    BOUNDARY_WRAP,   // Leave on one side, re-enter on the other (a torus)
+    BOUNDARY_POLICY_COUNT
+} BoundaryPolicy;
+
+// Which food a life form steers towards
+typedef enum {
+    SENSE_GLOBAL, // The nearest food anywhere in the world
+    SENSE_LOCAL,  // The nearest food within sense_radius; wander if there is none
+    SENSING_MODE_COUNT
+} SensingMode;
+
+// How a world finds out which food its life forms steer towards and touch
+typedef enum {
+    ENGINE_STEPPED, // Every life form searches for food and checks for contact every step
+    ENGINE_EVENT,   // Searches and contact checks only when they can have a new outcome (sparse worlds)
+    ENGINE_COUNT
+} EngineKind;
+
+// Where a world's food is
+typedef enum {
+    FOOD_POINTS, // Food sources at points, eaten whole on contact and respawned at random
+    FOOD_FIELD,  // A grid of food density that regrows and diffuses; life forms graze their cell
+    FOOD_MODEL_COUNT
+} FoodModel;
+
+// Physical parameters of a world. The kernels read them at run time, unless the build has a
+// kernel specialized for exactly these values (see ALIFE_SPECIALIZE in CMakeLists.txt).
+typedef struct {
+    double width;             // World size in simulation units
+    double height;
+    double life_form_radius;
+    double food_radius;
+    double sense_radius;      // SENSE_LOCAL only
+    BoundaryPolicy boundary;
+    SensingMode sensing;
+} WorldParams;
+
+// Deposit, decay, diffusion and attraction of one scent field
+typedef struct {
+    double deposit;    // Scent each life form adds to its cell per step, >= 0
+    double decay;      // Share of its scent a cell loses per step, 0..1
+    double diffusion;  // Share exchanged with each neighbouring cell per step, 0..0.25
+    double attraction; // Velocity change per unit of scent per unit length; negative to avoid the scent
+} ScentParams;
+
+// Energy budget and evolution rates of a world. Always read at run time, so kernel
+// specializations do not depend on them and parameter sweeps need no rebuild.
+typedef struct {
+    double reproduction_threshold; // Energy at which a life form splits
+    double energy_loss;            // Energy spent per step
+    double energy_gain;            // Energy of one food source
+    double mutation_width;         // Range of the speed factor mutation
+    double min_speed_factor;       // Offspring speed factors are clamped to [min, max], 0 < min <= max
+    double max_speed_factor;
+    double food_respawn_chance;    // 0..1
+    double field_regrowth;         // FOOD_FIELD: share of the missing density a cell regrows per step, 0..1
+    double field_diffusion;        // FOOD_FIELD: share exchanged with each neighbouring cell per step, 0..0.25
+    double field_graze;            // FOOD_FIELD: density a life form eats per step; one cell's worth is energy_gain
+    ScentParams scent[MAX_SCENT_FIELDS]; // The first WorldConfig.scent_fields are used
+} EcologyParams;
+
+// Everything world_create needs; start from world_default_config
+typedef struct {
+    int max_life_forms;       // Capacity of the life form array
+    int max_food_sources;     // Capacity of the food array
+    int initial_life_forms;
+    int initial_food_sources;
+    unsigned long long seed;  // Random seed; a world is fully determined by its config
+    int threads;              // Threads for the update phase, including the caller (1..MAX_THREADS)
+    int chunk_size;           // Life forms per work item
+    PinStrategy pin;          // Thread placement
+    WorldParams params;
+    EcologyParams ecology;
+    int specialized;          // 1 = use a specialized kernel for params if the build has one
+    EngineKind engine;        // ENGINE_STEPPED, or ENGINE_EVENT for sparse worlds
+    FoodModel food_model;     // FOOD_POINTS, or FOOD_FIELD (then there are no food sources)
+    int field_columns;        // Cells of the food field (FOOD_FIELD) and scent fields, which span the world
+    int field_rows;
+    int scent_fields;         // Scent fields (0..MAX_SCENT_FIELDS)
+} WorldConfig;
+
+// A threading and kernel configuration, as chosen by world_autotune
+typedef struct {
+    int threads;              // As WorldConfig.threads
+    int chunk_size;           // As WorldConfig.chunk_size
+    int specialized;          // As WorldConfig.specialized
+    double ns_per_step;       // Measured for this configuration
+    int candidates;           // Configurations timed to choose it
+} TuningResult;
+
+// Allocation counters for one phase, kept by the allocation tracker
+typedef struct {
+    long long allocs;
+    long long frees;
+    long long bytes_allocated;
+    long long bytes_freed;
+} AllocStats;
+
+// A simulation world; only used through the functions below
+typedef struct World World;
+
+// Several worlds evolving side by side, exchanging migrants (island model); only used through the
+// archipelago_* functions below
+typedef struct Archipelago Archipelago;
+
+// Everything archipelago_create needs besides the worlds' config; start from archipelago_default_config
+typedef struct {
+    int islands;            // Worlds, each stepped by a thread of its own
+    int migration_interval; // Steps between migrations
+    int migrants;           // Life forms each island sends to the next one per migration
+} IslandConfig;
+
+// --- Observer Events ---
+// Observers receive the events of a phase in one batch at the end of that phase, never one call
+// per event. step is the index of the step the events happened in (world_step_count before it).
+
+// Observer categories built into the library. The ALIFE_OBSERVERS CMake option sets the ones it
+// leaves out to 0; their recording code is then not compiled at all, and registering fails.
+#ifndef ALIFE_OBSERVE_BIRTH
+#define ALIFE_OBSERVE_BIRTH 1
+#endif
+#ifndef ALIFE_OBSERVE_DEATH
+#define ALIFE_OBSERVE_DEATH 1
+#endif
+#ifndef ALIFE_OBSERVE_FEED
+#define ALIFE_OBSERVE_FEED 1
+#endif
+#ifndef ALIFE_OBSERVE_STEP
+#define ALIFE_OBSERVE_STEP 1
+#endif
+
+typedef struct {
+    long long step;
+    int parent_id;
+    LifeForm child;     // The offspring as spawned
+} BirthEvent;
+
+typedef struct {
+    long long step;
+    LifeForm life_form; // Its last state, energy exhausted
+} DeathEvent;
+
+typedef struct {
+    long long step;
+    int life_form_id;
+    double food_x, food_y; // Position of the food eaten
+    double energy;         // Of the life form, after eating
+} FeedEvent;
+
+typedef struct {
+    long long step;
+    int life_forms;     // Counts after the step
+    int food;
+    int births;         // Events during the step
+    int deaths;
+    int feeds;
+} StepEvent;
+
+typedef void (*BirthObserver)(void* user, const BirthEvent* events, int count); // After reproduction
+typedef void (*DeathObserver)(void* user, const DeathEvent* events, int count); // After reproduction
+typedef void (*FeedObserver)(void* user, const FeedEvent* events, int count);   // After interaction
+typedef void (*StepObserver)(void* user, const StepEvent* event);               // After every step
+
+// --- World Lifetime ---
+void world_default_config(WorldConfig* config);
+World* world_create(const WorldConfig* config); // Returns NULL (after printing why) on failure
+World* world_load_checkpoint(const char* path, const WorldConfig* config); // Capacities, seed and params come from the file
+int world_reset(World* world, const WorldConfig* config); // As world_create, in place; returns 0 on failure
+void world_destroy(World* world);
+
+// --- Stepping ---
+int world_step(World* world);                          // Returns 0 if validation found a mismatch
+long long world_step_n(World* world, long long steps); // Returns the steps completed (< steps only on a mismatch)
+int world_set_validation(World* world, ValidationMode mode, double tolerance); // Returns 0 on failure
+
+// --- Runtime Parameters ---
+// Parameters can change during a run without losing its population. A change is validated at
+// once and applied at the next step boundary (the start of the next world_step), never mid-step.
+// Returns 0 (after printing why) if the values are invalid; the world then keeps its parameters.
+int world_set_params(World* world, const WorldParams* params);
+int world_set_ecology(World* world, const EcologyParams* ecology);
+int world_check_params(const WorldParams* params, const EcologyParams* ecology); // As the setters would, without a world
+
+// --- Rewind ---
+// A ring buffer of the last steps' states in budget_bytes of memory: every keyframe_interval-th
+// state in full, the others as deltas to the state before, the oldest dropped to make room.
+// world_rewind and world_forward move through it; a world_step after a rewind discards the
+// states after the current one. Moving restores the recorded parameters and ecology and discards
+// changes scheduled with world_set_params or world_set_ecology. Observers are not notified of moves.
+int world_enable_rewind(World* world, size_t budget_bytes, int keyframe_interval); // 0 bytes disables; returns 0 on failure
+long long world_rewind(World* world, long long steps);  // Returns the steps actually gone back
+long long world_forward(World* world, long long steps); // Returns the steps actually replayed
+long long world_rewind_depth(const World* world);       // Steps before the current one in the buffer
+long long world_forward_depth(const World* world);      // Steps after the current one in the buffer
+size_t world_rewind_bytes(const World* world);          // Bytes of the buffer in use
+
+// --- Auto-Tuning ---
+// world_autotune times candidate thread counts (up to max_threads), chunk sizes and kernel sets on
+// the world's current state for trial_steps steps each, and keeps the fastest. Trials run from a
+// saved copy of the state with observers, validation and rewind recording paused; the state, step
+// count and phase times are restored afterwards, so the run goes on exactly as it would have.
+// Scheduled parameter changes are applied first. Both return 0 (after printing why) on failure.
+int world_autotune(World* world, int max_threads, int trial_steps, TuningResult* result);
+int world_apply_tuning(World* world, const TuningResult* tuning); // Between steps, e.g. a cached result
+
+// --- Engines ---
+// The event-driven engine produces exactly the states of the stepped engine, step for step. Life
+// forms still move every step, but each one's food search and contact check are scheduled: from
+// how far the nearest and second nearest food are and how fast the life form can move, it works out
+// the first step at which the nearest food could change, food could come into sensing range or
+// within reach, and skips the work until then. Food appearing brings the schedules of life forms
+// near it forward; the reproduction pass runs only in steps with feeding or a predicted death. The
+// fewer life forms and food per area, the more work is skipped; in dense worlds the bookkeeping
+// costs more than it saves (tools/engine_crossover.py measures where). Takes effect at the next step.
+int world_set_engine(World* world, EngineKind engine); // Returns 0 (after printing why) if invalid
+EngineKind world_engine(const World* world);
+
+// --- Food Fields ---
+// A FOOD_FIELD world has no food sources but a grid of food density in [0, 1] spanning the world;
+// its cells stretch with the world when world_set_params resizes it. Every step, each life form
+// steers up the density gradient around its cell (keeping its heading where the field is flat) and
+// grazes up to field_graze from the cell it is in, gaining energy_gain per unit of density; then
+// every cell diffuses with its neighbours (across the edges on a torus, not through bouncing walls)
+// and regrows towards full. Both cost the same per life form however much food there is, and the
+// grid update is a stencil the compiler vectorizes. The event-driven engine only applies to point
+// food; feeding observers are not notified of grazing.
+FoodModel world_food_model(const World* world);
+void world_field_size(const World* world, int* columns, int* rows); // 0 x 0 with point food
+const float* world_field(const World* world); // Row-major densities; NULL with point food; valid until the next step
+double world_field_total(const World* world); // Sum of the densities
+
+// --- Scent Fields ---
+// A world can have up to MAX_SCENT_FIELDS scent fields on the food field's grid (WorldConfig
+// field_columns and field_rows), with either food model. Every step, after moving and steering
+// towards food, each life form turns by the gradient around its cell of every scent field times
+// that field's attraction (at most to its top speed) and leaves deposit in its cell; then every
+// cell diffuses with its neighbours, as the food field does, and loses decay of its scent. A field
+// that attracts lays trails that others follow; one that repels spreads the population out. The
+// deposits are reduced in life form order and the grid update runs on the worker pool in blocks of
+// rows, so results do not depend on the thread count. Scent worlds always use the stepped engine.
+int world_scent_fields(const World* world);
+const float* world_scent(const World* world, int index, int* columns, int* rows); // Row-major, valid until the next step
+
+// --- Forking ---
+// world_fork branches a world: the fork starts in the world's exact state (entities, random
+// generator, step, parameters and scheduled changes) and evolves independently, e.g. under other
+// parameters set with world_set_params or world_set_ecology. Its update phase runs on a pool of
+// its own with the given number of threads (unpinned); observers, validation and rewinding are
+// not forked. A fork is a plain copy: it costs time and memory in proportion to the live entities
+// (plus the food and scent grids), and neither world's steps are slowed by the other. Many forks
+// of one state can be stepped concurrently, each on its own thread. The world forked from must not
+// be stepped during world_fork.
+World* world_fork(const World* world, int threads); // Returns NULL (after printing why) on failure
+
+// --- Islands ---
+// Island i is a world created from the config with seed + i, stepped by its own thread (pinned
+// with the config's pin strategy; each world's own pool is unpinned). Islands form a ring: every
+// migration_interval steps each one sends randomly chosen life forms to the next through a
+// lock-free queue and takes in those of the one before. Migration is lock-step: an island cannot
+// pass a migration until the one before it has sent that migration's migrants, so the slowest
+// island sets the pace. Between migrations islands step independently (up to four migrations
+// ahead of the next island), blocking rather than spinning while they wait; runs are reproducible.
+void archipelago_default_config(IslandConfig* islands);
+Archipelago* archipelago_create(const WorldConfig* config, const IslandConfig* islands); // NULL (after printing why) on failure
+void archipelago_destroy(Archipelago* archipelago);
+long long archipelago_run(Archipelago* archipelago, long long steps); // Returns the steps every island completed
+int archipelago_island_count(const Archipelago* archipelago);
+World* archipelago_island(Archipelago* archipelago, int island);
+long long archipelago_migrant_count(const Archipelago* archipelago); // Life forms moved so far
+
+// --- Observers ---
+// One observer per category and world; NULL removes it. Batch observers are only called for phases
+// with at least one event. Each returns 0 (after printing why) if the category is not built in or
+// its event buffer cannot be allocated; buffers are allocated here, never during a step.
+int world_observe_births(World* world, BirthObserver observer, void* user);
+int world_observe_deaths(World* world, DeathObserver observer, void* user);
+int world_observe_feeding(World* world, FeedObserver observer, void* user);
+int world_observe_steps(World* world, StepObserver observer, void* user);
+
+// --- State Accessors ---
+long long world_step_count(const World* world);
+unsigned long long world_seed(const World* world);
+int world_life_form_count(const World* world);
+int world_food_count(const World* world);
+int world_max_life_forms(const World* world);
+int world_max_food_sources(const World* world);
+const WorldParams* world_params(const World* world);
+const EcologyParams* world_ecology(const World* world);
+const char* world_kernel_name(const World* world); // "generic" or the specialization in use
+double world_life_form_energy(const World* world, const LifeForm* life_form); // Its current energy
+// The entity arrays themselves; valid until the next step, world_fork or world_destroy
+const LifeForm* world_life_forms(const World* world);
+const Food* world_food(const World* world);
+// Bulk copies into caller arrays; each returns the number of entries written (at most max)
+int world_copy_positions(const World* world, double* xy, int max);       // x0, y0, x1, y1, ...
+int world_copy_energies(const World* world, double* energies, int max);   // Current energies
+int world_copy_food_positions(const World* world, double* xy, int max);  // Present food only
+
+// --- Checkpoints ---
+int world_save_checkpoint(const World* world, const char* path); // Returns 0 on failure
+unsigned long long world_state_hash(const World* world);
+
+// --- Timing and Threads ---
+const double* world_phase_times_ns(const World* world); // Accumulated per phase since creation or reset
+void world_reset_phase_times(World* world);
+const char* world_phase_name(int phase);
+int world_thread_count(const World* world);
+PinStrategy world_pin_strategy(const World* world);
+const char* pin_strategy_name(PinStrategy strategy);
+int parse_pin_strategy(const char* name); // Returns the PinStrategy with the given name, or -1
+double alife_now_ns(); // Monotonic wall-clock time in nanoseconds, as used for phase timing
+
+// --- Parameter Names ---
+const char* boundary_policy_name(BoundaryPolicy policy);
+int parse_boundary_policy(const char* name); // Returns the BoundaryPolicy with the given name, or -1
+const char* sensing_mode_name(SensingMode mode);
+int parse_sensing_mode(const char* name);    // Returns the SensingMode with the given name, or -1
+const char* engine_name(EngineKind engine);
+int parse_engine(const char* name);          // Returns the EngineKind with the given name, or -1
+const char* food_model_name(FoodModel model);
+int parse_food_model(const char* name);      // Returns the FoodModel with the given name, or -1
+
+#ifdef ALIFE_TRACK_ALLOCS
+// --- Allocation Tracking (builds with -DALIFE_TRACK_ALLOCS) ---
+// Counts every library allocation per phase, over all worlds, and per step; each thread counts
+// the steps it runs, so the steady-state assertion holds for every world stepped in parallel
+void alife_alloc_reset_stats();
+void alife_alloc_set_assert_steady_state(int enabled); // Abort if a step after the first allocates
+AllocStats alife_alloc_phase_stats(int phase);          // phase == PHASE_COUNT: outside steps
+void alife_alloc_print_report(FILE* out);
+#endif
+
+#ifdef ALIFE_PROFILER
+// --- Sampling Profiler (builds with -DALIFE_PROFILER) ---
+int alife_profiler_start(int hz); // Returns 0 on failure
+void alife_profiler_stop();
+void alife_profiler_report(FILE* out);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ALIFE_H
@@ -0,0 +1,457 @@
+#ifndef ALIFE_INTERNAL_H
+#define ALIFE_INTERNAL_H
+
+// Definitions shared by the library's source files; not part of the public API
+
+#include "alife.h"
+
+#include <stddef.h>    // For size_t
+#include <stdatomic.h> // For the worker pool's shared chunk counter
+#include <pthread.h>   // For the worker pool that runs the update phase in parallel
+
+// --- Simulation Parameters ---
+#define MAX_SPEED 1.5 // Max speed in simulation units
+
+// --- Profiler Parameters ---
+#define PROFILER_MAX_SAMPLES (1 << 20) // Samples beyond this are counted as dropped
+#define PROFILER_TOP_FUNCTIONS 15     // Functions listed in the report
+
+// --- Tuning Parameters ---
+#define TUNING_REPEATS 2      // Trials per candidate; the fastest counts
+#define TUNING_MIN_GAIN 0.03  // A candidate must be this much faster than the best so far to replace it
+
+// --- Checkpoint Format ---
+#define CHECKPOINT_MAGIC "ALIFE-CHECKPOINT"
+#define CHECKPOINT_VERSION 7 // Older files load with the default params (version 1) and ecology (1 and 2),
+                             // their energies as of the checkpoint's step (1 to 3), point food (1 to 4),
+                             // no scent (1 to 5) and the default speed factor range (1 to 6)
+
+// --- Struct Definitions ---
+
+// One worker thread of a pool
+typedef struct {
+    pthread_t thread;
+    struct WorkerPool* pool;
+    int index; // 1..thread_count - 1; the thread calling parallel_for is thread 0
+} WorkerThread;
+
+// Worker pool. A phase is split into chunks of life forms that the stepping thread
+// and thread_count - 1 workers take from a shared counter.
+typedef struct WorkerPool {
+    int thread_count;
+    int chunk_size;
+    PinStrategy pin_strategy;
+    WorkerThread workers[MAX_THREADS];
+    int worker_count;                 // Running worker threads (thread_count - 1 once started)
+    pthread_mutex_t mutex;
+    pthread_cond_t start_cond;
+    pthread_cond_t done_cond;
+    long generation;                  // Bumped for every parallel_for; wakes the workers
+    int busy;                         // Workers still working on the current parallel_for
+    int shutdown;
+    void (*task)(World* world, int begin, int end);
+    World* task_world;
+    int items;
+    int phase;                        // current_phase of the thread calling parallel_for
+#ifdef ALIFE_TRACK_ALLOCS
+    struct AllocStepCounters* alloc_step; // ...and the step counters its allocations go to
+#endif
+    int task_chunk;                   // Items per chunk of the current task
+    atomic_int next_item;
+} WorkerPool;
+
+// A copy of the simulation state, so that a phase can be run twice from the same state
+typedef struct {
+    LifeForm* life_forms;
+    Food* food_sources;
+    int life_form_count;
+    int food_count;
+    unsigned long long rng_state;
+    float* field_cells; // FOOD_FIELD worlds only
+    float* scent_cells; // Worlds with scent fields only
+} StateSnapshot;
+
+// The update and interaction kernels for one parameter set (kernels.c)
+typedef struct {
+    const char* name;                                      // "generic", or the ALIFE_SPECIALIZE entry
+    WorldParams params;                                    // What a specialization was built for
+    void (*update_range)(World* world, int begin, int end); // Updates life forms [begin, end)
+    void (*interact)(World* world);                        // Feeding and food respawn
+    void (*update_events_range)(World* world, int begin, int end); // The same, for the event-driven engine
+    void (*interact_events)(World* world);
+    void (*update_field_range)(World* world, int begin, int end); // The same, for FOOD_FIELD worlds
+    void (*graze)(World* world);
+    void (*follow_scent_range)(World* world, int begin, int end); // Scent steering of life forms [begin, end)
+} KernelSet;
+
+// What the event-driven engine knows about one life form's food (events.c), in an array parallel to
+// life_forms. Distances are from where the life form was at the search; it moves at most reach per
+// step, so the nearest food stays nearest while the gap to the second nearest exceeds 2 * reach per
+// step since, and no food is touched while the nearest is farther than the radii plus reach per step.
+// Food appearing later counts as nearest (no target) or second nearest, at its distance at the time
+// less reach per step since the search.
+typedef struct {
+    long long searched;     // Step count of the last food search
+    long long search_until; // Its outcome holds for the steps before this one
+    long long contact_from; // No food can be touched in the steps before this one
+    double reach;           // Most the life form can move in a step
+    double nearest;         // Distance to the nearest present food at the search (infinite if none)
+    double second;          // To the second nearest
+    int target;             // Food steered towards (index into food_sources), -1 to wander
+} FoodSchedule;
+
+#define SCHEDULE_SLACK 1e-9          // Safety margin of schedule distances, relative to the world size
+#define SCHEDULE_HORIZON (1LL << 40) // Steps a schedule reaches ahead at most
+
+// Food density grid of a FOOD_FIELD world (field.c), row-major. The stencil writes the next
+// densities into next and the two are swapped.
+typedef struct {
+    int columns;
+    int rows;
+    float* cells; // columns * rows densities in [0, 1], padded with a zero to a whole number of 8-byte words
+    float* next;
+} FoodField;
+
+// Scent grids of a world (field.c) on the food field's grid, one after another in cells, each padded
+// like FoodField's. The stencil writes into next and the two are swapped.
+typedef struct {
+    int count;           // 0..MAX_SCENT_FIELDS; no buffers with 0
+    int columns;
+    int rows;
+    float* cells;
+    float* next;
+    int* deposit_cells;  // Parallel to life_forms: the cell each life form leaves scent in this step
+} ScentFields;
+
+#define FIELD_BLOCK_ROWS 8         // Rows of a grid per work item of the stencil
+#define FIELD_PARALLEL_CELLS 16384 // Grids with fewer cells are updated on the stepping thread alone
+
+// Rewind ring buffer (rewind.c): variable-size records in one preallocated arena, oldest first.
+// Records are contiguous; when the next one does not fit before the end of the arena, it goes to
+// the start, and the records in [start, wrap_end) and [0, end) are then in use.
+typedef struct {
+    unsigned char* arena;   // NULL while rewind is off
+    size_t capacity;
+    size_t start;           // Offset of the oldest record
+    size_t end;             // Offset just after the newest record
+    size_t wrap_end;        // End of the records before the wrap, while wrapped
+    int wrapped;
+    long long count;        // Records in the buffer
+    size_t newest;          // Offset of the newest record
+    size_t cursor;          // Offset of the record the world's state is (the newest, unless rewound)
+    int keyframe_interval;
+    int since_keyframe;     // Deltas between the last keyframe and the cursor
+    StateSnapshot last;     // State at the cursor: the base of the next delta
+    size_t* chain;          // Scratch: offsets from a keyframe to a record, keyframe_interval entries
+} RewindBuffer;
+
+// Registered observers and the events of the current phase (observers.c)
+typedef struct {
+    BirthObserver birth;
+    DeathObserver death;
+    FeedObserver feed;
+    StepObserver step;
+    void* birth_user;
+    void* death_user;
+    void* feed_user;
+    void* step_user;
+    // Event buffers, allocated at the world's capacities when an observer is first registered
+    BirthEvent* births;   // At most max_life_forms per step
+    DeathEvent* deaths;   // At most max_life_forms per step
+    FeedEvent* feeds;     // At most max_food_sources per step: every food source is eaten at most once
+    int birth_count;
+    int death_count;
+    int feed_count;
+    StepEvent step_totals; // Counts of the current step, for the step observer
+} Observers;
+
+struct World {
+    // Entities
+    LifeForm* life_forms;
+    LifeForm* next_life_forms; // Scratch array the reproduction phase builds the next generation in
+    Food* food_sources;
+    int life_form_count;
+    int food_count;
+    int max_life_forms;
+    int max_food_sources;
+
+    // Random number generator state (xorshift64*); saved in checkpoints so runs can be resumed exactly
+    unsigned long long rng_state;
+    unsigned long long seed; // Seed the run started from
+    long long step;          // Steps completed since the run started
+    long long state_version; // Changes whenever the entities may change (steps, rewinds, migrations, resets)
+    int updated;             // Set from the end of a step's update phase to the end of the step
+
+    WorldParams params;
+    EcologyParams ecology;
+    const KernelSet* kernels; // Specialized for params if the build has such kernels, else generic
+    int specialized;          // Whether kernels may be specialized (WorldConfig.specialized)
+
+    // Parameter changes waiting for the next step boundary (world_set_params, world_set_ecology)
+    int pending_changes;      // PENDING_* flags
+    WorldParams pending_params;
+    EcologyParams pending_ecology;
+
+    // Accumulated wall-clock time per phase in nanoseconds
+    double phase_time_ns[PHASE_COUNT];
+
+    WorkerPool pool;
+
+    Observers observers;
+
+    RewindBuffer rewind;
+
+    // Validation (world_set_validation): snapshots of the state before a phase and after its reference kernel
+    ValidationMode validation_mode;
+    double validation_tolerance;
+    StateSnapshot validation_before;
+    StateSnapshot validation_reference;
+
+    // Event-driven engine (events.c); the arrays are allocated with the world, whichever engine runs
+    EngineKind engine;
+    FoodSchedule* schedules;      // Parallel to life_forms
+    FoodSchedule* next_schedules; // Parallel to next_life_forms
+    int* food_remap;              // Scratch: where every food source moves when the food array is compacted
+    long long schedule_version;   // state_version the schedules are up to date for
+    long long next_death;         // No life form dies before this step count
+    int reproduce_due;            // Some life form may have the energy to reproduce
+
+    FoodModel food_model;
+    FoodField field;              // Allocated with the world if food_model is FOOD_FIELD
+    ScentFields scent;
+};
+
+// Flags of World.pending_changes
+#define PENDING_PARAMS 1
+#define PENDING_ECOLOGY 2
+
+// A phase implementation; world_step runs one per phase
+typedef void (*PhaseKernel)(World* world);
+
+// --- Memory Allocation ---
+// The library allocates through sim_malloc/sim_free so that tracking builds can count
+// every allocation per phase and per step; otherwise they are plain malloc/free.
+#ifdef ALIFE_TRACK_ALLOCS
+void* tracked_malloc(size_t size);
+void tracked_free(void* ptr);
+void alloc_end_step();
+// Per-step counters of a stepping thread. Pool workers set alloc_step_counters to those of the
+// thread calling parallel_for, so their allocations count against its step; NULL = the thread's own.
+typedef struct AllocStepCounters AllocStepCounters;
+extern _Thread_local AllocStepCounters* alloc_step_counters;
+AllocStepCounters* alloc_current_step(); // The counters the calling thread's allocations go to
+#define sim_malloc(size) tracked_malloc(size)
+#define sim_free(ptr) tracked_free(ptr)
+#else
+#define sim_malloc(size) malloc(size)
+#define sim_free(ptr) free(ptr)
+#endif
+
+// --- Event Recording ---
+// The kernels record events through these macros. A category left out by ALIFE_OBSERVERS compiles
+// to nothing; a built-in category costs one predictable branch per event site until observed.
+#if ALIFE_OBSERVE_BIRTH
+#define RECORD_BIRTH(world, parent, child) \
+    do { if ((world)->observers.birth != NULL) record_birth(world, parent, child); } while (0)
+#else
+#define RECORD_BIRTH(world, parent, child) ((void)0)
+#endif
+#if ALIFE_OBSERVE_DEATH
+#define RECORD_DEATH(world, lf) \
+    do { if ((world)->observers.death != NULL) record_death(world, lf); } while (0)
+#else
+#define RECORD_DEATH(world, lf) ((void)0)
+#endif
+#if ALIFE_OBSERVE_FEED
+#define RECORD_FEED(world, lf, food) \
+    do { if ((world)->observers.feed != NULL) record_feed(world, lf, food); } while (0)
+#else
+#define RECORD_FEED(world, lf, food) ((void)0)
+#endif
+
+// --- Lazy Energy ---
+// Energy is stored with the step count it was stored at and evaluated in closed form when read: the
+// update phase of every step since subtracted energy_loss and clamped to [0, MAX_ENERGY]. The update
+// kernels therefore never touch it, and since energy only falls between feedings, the step at which
+// it runs out is predicted whenever it is stored; the reproduction phase compares step counts to
+// find the dead. A change of energy_loss re-stores every life form's energy (apply_pending_changes).
+
+// Update phases applied so far: the step count, plus one from the end of a step's update phase on
+static inline long long energy_clock(const World* world) {
+    return world->step + world->updated;
+}
+
+// Energy of lf once clock update phases have been applied (clock >= lf->energy_step)
+static inline double life_form_energy_at(const World* world, const LifeForm* lf, long long clock) {
+    long long updates = clock - lf->energy_step;
+    if (updates <= 0) {
+        return lf->energy;
+    }
+    double energy = lf->energy - world->ecology.energy_loss;
+    if (energy > MAX_ENERGY) energy = MAX_ENERGY;
+    energy -= (double)(updates - 1) * world->ecology.energy_loss;
+    return energy > 0 ? energy : 0;
+}
+
+static inline void record_birth(World* world, const LifeForm* parent, const LifeForm* child) {
+    BirthEvent* event = &world->observers.births[world->observers.birth_count++];
+    event->step = world->step;
+    event->parent_id = parent->id;
+    event->child = *child;
+}
+
+static inline void record_death(World* world, const LifeForm* lf) {
+    DeathEvent* event = &world->observers.deaths[world->observers.death_count++];
+    event->step = world->step;
+    event->life_form = *lf;
+    event->life_form.energy = life_form_energy_at(world, lf, energy_clock(world));
+    event->life_form.energy_step = energy_clock(world);
+}
+
+static inline void record_feed(World* world, const LifeForm* lf, const Food* food) {
+    FeedEvent* event = &world->observers.feeds[world->observers.feed_count++];
+    event->step = world->step;
+    event->life_form_id = lf->id;
+    event->food_x = food->x;
+    event->food_y = food->y;
+    event->energy = lf->energy;
+}
+
+// --- Event-Driven Engine ---
+
+// The event-driven engine only schedules the searches of point food without scent; other worlds
+// take the stepped engine's kernels whichever engine is selected
+static inline int event_engine_runs(const World* world) {
+    return world->engine == ENGINE_EVENT && world->food_model == FOOD_POINTS && world->scent.count == 0;
+}
+
+// --- Food and Scent Fields ---
+
+// Cells of a columns x rows grid, padded to a whole number of 8-byte words
+static inline size_t grid_cells(int columns, int rows) {
+    return (size_t)((columns * rows + 1) & ~1);
+}
+
+// Bytes of the field's cells, padding included; 0 with point food
+static inline size_t field_bytes(const World* world) {
+    return world->field.cells == NULL ? 0 : grid_cells(world->field.columns, world->field.rows) * sizeof(float);
+}
+
+// Bytes of all scent grids, padding included; 0 without scent
+static inline size_t scent_bytes(const World* world) {
+    return (size_t)world->scent.count * grid_cells(world->scent.columns, world->scent.rows) * sizeof(float);
+}
+
+// Phase the calling thread is in; PHASE_COUNT outside a step. For the profiler and the allocation
+// tracker. Per thread, so that worlds stepped by different threads do not mix up their phases;
+// pool workers take on the phase of the parallel_for they work for.
+extern _Thread_local int current_phase;
+
+// Phase kernels (world.c). The reference kernels are the plain serial implementation the optimized
+// kernels must reproduce; world_step runs the optimized ones and validation runs both.
+extern const PhaseKernel reference_kernels[PHASE_COUNT];
+extern const PhaseKernel phase_kernels[PHASE_COUNT];
+
+// --- Function Prototypes ---
+
+// Random numbers (world.c)
+void seed_random(World* world, unsigned long long seed);
+unsigned int random_u32(World* world);
+double random_unit(World* world);
+
+// Simulation core (world.c)
+World* world_allocate(const WorldConfig* config); // Empty world at the config's capacities, pool started
+int allocate_entities(World* world);
+void release_entities(World* world);
+void initialize_simulation(World* world, int initial_life_forms, int initial_food_sources);
+void spawn_life_form(World* world, double x, double y, double energy, double speed_factor,
+                     unsigned char r, unsigned char g, unsigned char b);
+void set_life_form_energy(World* world, LifeForm* lf, double energy);
+void predict_death(const World* world, LifeForm* lf);
+void spawn_food(World* world, double x, double y);
+int any_food_present(const World* world);
+void update_phase(World* world);
+void update_phase_reference(World* world);
+void interact_phase(World* world);
+void interact_phase_reference(World* world);
+void reproduce_phase(World* world);
+void reproduce_phase_reference(World* world);
+void reproduce_life_forms(World* world);
+void finish_step(World* world);
+void apply_pending_changes(World* world);
+void begin_phase(int phase);
+
+// World parameters and kernel selection (kernels.c)
+extern const KernelSet generic_kernels;
+void update_life_form_range_generic(World* world, int begin, int end);
+void handle_interactions_generic(World* world);
+void update_life_form_range_field_generic(World* world, int begin, int end);
+void graze_field_generic(World* world);
+void follow_scent_range_generic(World* world, int begin, int end);
+int params_match(const WorldParams* built_for, const WorldParams* params);
+const KernelSet* select_kernels(const WorldParams* params, int specialized);
+void default_world_params(WorldParams* params);
+int check_world_params(const WorldParams* params);
+void default_ecology_params(EcologyParams* ecology);
+int check_ecology_params(const EcologyParams* ecology);
+
+// Food and scent fields (field.c)
+int check_field_config(const WorldConfig* config);
+int allocate_field(World* world, int columns, int rows);
+void free_field(World* world);
+void initialize_field(World* world);
+void step_food_field(World* world);
+void step_food_field_reference(World* world);
+int allocate_scent(World* world, int count, int columns, int rows);
+void free_scent(World* world);
+void deposit_scent(World* world);
+void step_scent(World* world);
+void step_scent_reference(World* world);
+
+// Event-driven engine (events.c)
+int allocate_schedules(World* world);
+void free_schedules(World* world);
+void begin_event_step(World* world);
+void schedule_food_search(const World* world, const LifeForm* lf, FoodSchedule* schedule, int target,
+                          double nearest_sq, double second_sq);
+void schedule_contact(const World* world, FoodSchedule* schedule, double nearest_sq);
+void schedule_new_food(World* world, int food);
+void schedule_food_compaction(World* world);
+void event_reproduce_phase(World* world);
+
+// Observers (observers.c)
+void clear_events(World* world);
+void notify_phase_observers(World* world);
+void notify_step_observer(World* world);
+void free_observers(World* world);
+
+// Worker pool (pool.c)
+int start_worker_pool(WorkerPool* pool);
+void stop_worker_pool(WorkerPool* pool);
+void* worker_main(void* arg);
+void pin_current_thread(const WorkerPool* pool, int thread_index);
+void pin_thread(PinStrategy strategy, int thread_index, int thread_count);
+void run_pool_chunks(WorkerPool* pool);
+void parallel_for(World* world, int items, void (*task)(World* world, int begin, int end));
+void parallel_for_blocks(World* world, int items, int block, void (*task)(World* world, int begin, int end));
+
+// Validation (validate.c)
+int allocate_snapshot(const World* world, StateSnapshot* snapshot);
+void free_snapshot(StateSnapshot* snapshot);
+void save_snapshot(const World* world, StateSnapshot* snapshot);
+void restore_snapshot(World* world, const StateSnapshot* snapshot);
+int values_match(const World* world, double reference, double optimized);
+int check_field(const World* world, const char* entity, int index, const char* field,
+                double reference, double optimized);
+int compare_with_snapshot(const World* world, const StateSnapshot* reference);
+int validate_step(World* world);
+
+// Rewind (rewind.c)
+void record_rewind_state(World* world);
+void free_rewind_buffer(World* world);
+void reset_rewind_buffer(World* world);
+
+// Checkpoints (checkpoint.c)
+unsigned long long hash_bytes(unsigned long long hash, const void* data, size_t len);
+
+#endif // ALIFE_INTERNAL_H
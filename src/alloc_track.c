@@ -0,0 +1,176 @@
+#include <stdio.h>    // For the allocation report (fprintf)
+#include <stddef.h>   // For max_align_t (allocation headers)
+#include <stdlib.h>   // For malloc, free, abort
+
+#include "alife_internal.h"
+
+#ifdef ALIFE_TRACK_ALLOCS
+// --- Allocation Tracking ---
+
+// Allocation tracking (debug/profiling builds with -DALIFE_TRACK_ALLOCS).
+// Several worlds may step at once on different threads (islands, GA jobs, branches), so the
+// totals are atomic and each step is counted by the thread that steps it. Pool workers count
+// into the step of the thread they work for (see alloc_step_counters).
+typedef struct {
+    atomic_llong allocs;
+    atomic_llong frees;
+    atomic_llong bytes_allocated;
+    atomic_llong bytes_freed;
+} AllocCounters;
+
+struct AllocStepCounters {
+    AllocCounters step;    // Current step only; reset by alloc_end_step
+    long long steps;       // Steps this thread completed since alife_alloc_reset_stats
+    long generation;       // alloc_generation when steps was last reset
+};
+
+// Index PHASE_COUNT collects allocations made outside steps.
+static AllocCounters alloc_phase_stats[PHASE_COUNT + 1];
+static atomic_llong alloc_steps;            // Steps completed since alife_alloc_reset_stats, all threads
+static atomic_llong alloc_steps_allocating; // Of those, steps that allocated at least once
+static atomic_llong alloc_max_step_bytes;   // Most bytes allocated by a single step
+static atomic_llong alloc_live_bytes;
+static atomic_llong alloc_peak_live_bytes;
+static atomic_long alloc_generation;        // Bumped by alife_alloc_reset_stats
+static atomic_int alloc_assert_steady_state; // Abort if a step after a thread's first allocates
+
+static _Thread_local AllocStepCounters thread_step_counters;
+_Thread_local AllocStepCounters* alloc_step_counters = NULL;
+
+// Returns the counters of the step the calling thread allocates for: its own, or those of the
+// thread whose parallel_for it works on
+AllocStepCounters* alloc_current_step() {
+    return alloc_step_counters != NULL ? alloc_step_counters : &thread_step_counters;
+}
+
+// Raises *max to value unless it is already larger
+static void atomic_max(atomic_llong* max, long long value) {
+    long long seen = atomic_load(max);
+    while (value > seen && !atomic_compare_exchange_weak(max, &seen, value)) {
+    }
+}
+
+// Adds one allocation or free of size bytes to counters
+static void count_block(AllocCounters* counters, int is_free, long long size) {
+    atomic_fetch_add(is_free ? &counters->frees : &counters->allocs, 1);
+    atomic_fetch_add(is_free ? &counters->bytes_freed : &counters->bytes_allocated, size);
+}
+
+// Zeroes counters
+static void clear_counters(AllocCounters* counters) {
+    atomic_store(&counters->allocs, 0);
+    atomic_store(&counters->frees, 0);
+    atomic_store(&counters->bytes_allocated, 0);
+    atomic_store(&counters->bytes_freed, 0);
+}
+
+// Every tracked block is preceded by a header holding its size, padded so the payload stays aligned
+typedef union {
+    size_t size;
+    max_align_t align;
+} AllocHeader;
+
+// Counts an allocation against the current phase (and the current step, inside world_step)
+void* tracked_malloc(size_t size) {
+    AllocHeader* header = (AllocHeader*)malloc(sizeof(AllocHeader) + size);
+    if (header == NULL) {
+        return NULL;
+    }
+    header->size = size;
+
+    count_block(&alloc_phase_stats[current_phase], 0, (long long)size);
+    if (current_phase < PHASE_COUNT) {
+        count_block(&alloc_current_step()->step, 0, (long long)size);
+    }
+    atomic_max(&alloc_peak_live_bytes, atomic_fetch_add(&alloc_live_bytes, (long long)size) + (long long)size);
+    return header + 1;
+}
+
+// Counts a free against the current phase (and the current step, inside world_step)
+void tracked_free(void* ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    AllocHeader* header = (AllocHeader*)ptr - 1;
+
+    count_block(&alloc_phase_stats[current_phase], 1, (long long)header->size);
+    if (current_phase < PHASE_COUNT) {
+        count_block(&alloc_current_step()->step, 1, (long long)header->size);
+    }
+    atomic_fetch_sub(&alloc_live_bytes, (long long)header->size);
+    free(header);
+}
+
+// Clears the per-phase and per-step counters (live and peak bytes keep counting). Other threads
+// start counting their steps from 0 again at their next step.
+void alife_alloc_reset_stats() {
+    for (int p = 0; p <= PHASE_COUNT; ++p) {
+        clear_counters(&alloc_phase_stats[p]);
+    }
+    atomic_store(&alloc_steps, 0);
+    atomic_store(&alloc_steps_allocating, 0);
+    atomic_store(&alloc_max_step_bytes, 0);
+    AllocStepCounters* counters = alloc_current_step();
+    clear_counters(&counters->step);
+    counters->steps = 0;
+    counters->generation = atomic_fetch_add(&alloc_generation, 1) + 1;
+}
+
+// Closes the per-step counters of the calling thread; called at the end of every step.
+// With alloc_assert_steady_state set, any allocation or free in a step other than the
+// first one the thread completes after alife_alloc_reset_stats aborts the program with a report.
+void alloc_end_step() {
+    AllocStepCounters* counters = alloc_current_step();
+    long generation = atomic_load(&alloc_generation);
+    if (counters->generation != generation) {
+        counters->steps = 0;
+        counters->generation = generation;
+    }
+    long long step_index = counters->steps++;
+    long long allocs = atomic_load(&counters->step.allocs);
+    long long frees = atomic_load(&counters->step.frees);
+    long long bytes = atomic_load(&counters->step.bytes_allocated);
+    atomic_fetch_add(&alloc_steps, 1);
+    atomic_max(&alloc_max_step_bytes, bytes);
+    if (allocs > 0 || frees > 0) {
+        atomic_fetch_add(&alloc_steps_allocating, 1);
+        if (atomic_load(&alloc_assert_steady_state) && step_index > 0) {
+            fprintf(stderr, "Steady-state step %lld allocated %lld bytes in %lld allocation(s) and made %lld free(s)!\n",
+                    step_index, bytes, allocs, frees);
+            alife_alloc_print_report(stderr);
+            abort();
+        }
+    }
+    clear_counters(&counters->step);
+}
+
+// Enables or disables the steady-state assertion of alloc_end_step
+void alife_alloc_set_assert_steady_state(int enabled) {
+    atomic_store(&alloc_assert_steady_state, enabled);
+}
+
+// Returns the counters of one phase, or of everything outside steps for PHASE_COUNT
+AllocStats alife_alloc_phase_stats(int phase) {
+    AllocStats stats;
+    stats.allocs = atomic_load(&alloc_phase_stats[phase].allocs);
+    stats.frees = atomic_load(&alloc_phase_stats[phase].frees);
+    stats.bytes_allocated = atomic_load(&alloc_phase_stats[phase].bytes_allocated);
+    stats.bytes_freed = atomic_load(&alloc_phase_stats[phase].bytes_freed);
+    return stats;
+}
+
+// Prints allocation counts and bytes per phase and per step
+void alife_alloc_print_report(FILE* out) {
+    fprintf(out, "Allocation report: %lld step(s), %lld of them allocating\n", (long long)atomic_load(&alloc_steps),
+            (long long)atomic_load(&alloc_steps_allocating));
+    fprintf(out, "  %-10s %10s %10s %14s %14s\n", "phase", "allocs", "frees", "bytes alloc", "bytes freed");
+    for (int p = 0; p <= PHASE_COUNT; ++p) {
+        AllocStats st = alife_alloc_phase_stats(p);
+        fprintf(out, "  %-10s %10lld %10lld %14lld %14lld\n", world_phase_name(p),
+                st.allocs, st.frees, st.bytes_allocated, st.bytes_freed);
+    }
+    fprintf(out, "  max bytes allocated by one step: %lld; live: %lld bytes (peak %lld)\n",
+            (long long)atomic_load(&alloc_max_step_bytes), (long long)atomic_load(&alloc_live_bytes),
+            (long long)atomic_load(&alloc_peak_live_bytes));
+}
+#endif
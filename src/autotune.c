@@ -0,0 +1,174 @@
+#include <stdio.h>    // For error messages (fprintf)
+#include <string.h>   // For memset, memcpy
+
+#include "alife_internal.h"
+
+// Chunk sizes tried once the thread count is chosen
+static const int tuning_chunk_sizes[] = { 16, 32, 64, 128, 256 };
+
+// --- Threading ---
+
+// Restarts the world's worker pool with threads threads and chunks of chunk_size life forms; falls
+// back to one thread and returns 0 if the workers cannot be started
+static int restart_pool(World* world, int threads, int chunk_size) {
+    if (threads == world->pool.thread_count && chunk_size == world->pool.chunk_size) {
+        return 1;
+    }
+    stop_worker_pool(&world->pool);
+    world->pool.thread_count = threads;
+    world->pool.chunk_size = chunk_size;
+    if (start_worker_pool(&world->pool)) {
+        return 1;
+    }
+    // start_worker_pool has stopped the workers it started; one thread needs none
+    world->pool.thread_count = 1;
+    start_worker_pool(&world->pool);
+    return 0;
+}
+
+// Selects the generic kernels, or the specialized ones for the world's params if the build has them
+static void use_kernels(World* world, int specialized) {
+    world->specialized = specialized;
+    world->kernels = select_kernels(&world->params, specialized);
+}
+
+// --- Trials ---
+// Every candidate runs from the same saved state with observers, validation and rewind recording
+// paused, so that neither the run nor anything watching it notices the trials.
+
+typedef struct {
+    StateSnapshot state;
+    long long step;
+    double phase_time_ns[PHASE_COUNT];
+    Observers observers;
+    ValidationMode validation_mode;
+    unsigned char* rewind_arena;
+} TuningState;
+
+// Returns the best time per step of trial_steps steps from the saved state, over TUNING_REPEATS trials
+static double time_candidate(World* world, const TuningState* saved, int trial_steps) {
+    double best = 0.0;
+    for (int repeat = 0; repeat < TUNING_REPEATS; ++repeat) {
+        restore_snapshot(world, &saved->state);
+        world->step = saved->step;
+        world->state_version++; // Nothing derived from the state of the last trial holds
+        double start = alife_now_ns();
+        for (int i = 0; i < trial_steps; ++i) {
+            world_step(world);
+        }
+        double ns = (alife_now_ns() - start) / trial_steps;
+        if (repeat == 0 || ns < best) {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+// Times threads, chunk_size and kernels; makes them the best so far if faster by TUNING_MIN_GAIN
+static void try_candidate(World* world, const TuningState* saved, int trial_steps, int threads, int chunk_size,
+                          int specialized, TuningResult* best) {
+    if (!restart_pool(world, threads, chunk_size)) {
+        return;
+    }
+    use_kernels(world, specialized);
+    double ns = time_candidate(world, saved, trial_steps);
+    best->candidates++;
+    if (best->candidates == 1 || ns < best->ns_per_step * (1.0 - TUNING_MIN_GAIN)) {
+        best->threads = threads;
+        best->chunk_size = chunk_size;
+        best->specialized = specialized;
+        best->ns_per_step = ns;
+    }
+}
+
+// --- Auto-Tuning API ---
+
+// Times candidate configurations on the world's current state and keeps the fastest: first the
+// thread count (1, 2, 4, ... and max_threads), then the chunk size, then generic against specialized
+// kernels. Each stage keeps a candidate only if it is clearly faster, so ties go to fewer threads
+// and the defaults. The state, step count and phase times are restored afterwards. Returns 0 (after
+// printing why) on failure; the world then keeps its configuration.
+int world_autotune(World* world, int max_threads, int trial_steps, TuningResult* result) {
+    if (max_threads < 1 || max_threads > MAX_THREADS || trial_steps < 1) {
+        fprintf(stderr, "Tuning needs 1 to %d threads and at least 1 trial step\n", MAX_THREADS);
+        return 0;
+    }
+    if (world->pending_changes != 0) {
+        apply_pending_changes(world);
+    }
+    TuningState saved;
+    if (!allocate_snapshot(world, &saved.state)) {
+        fprintf(stderr, "Memory allocation failed for tuning!\n");
+        return 0;
+    }
+    save_snapshot(world, &saved.state);
+    saved.step = world->step;
+    memcpy(saved.phase_time_ns, world->phase_time_ns, sizeof(saved.phase_time_ns));
+    saved.observers = world->observers;
+    saved.validation_mode = world->validation_mode;
+    saved.rewind_arena = world->rewind.arena;
+    world->observers.birth = NULL;
+    world->observers.death = NULL;
+    world->observers.feed = NULL;
+    world->observers.step = NULL;
+    world->validation_mode = VALIDATE_OFF;
+    world->rewind.arena = NULL;
+
+    int chunk_size = world->pool.chunk_size;
+    int specialized = world->specialized;
+    TuningResult best;
+    memset(&best, 0, sizeof(best));
+    for (int threads = 1;; threads *= 2) {
+        threads = threads < max_threads ? threads : max_threads;
+        try_candidate(world, &saved, trial_steps, threads, chunk_size, specialized, &best);
+        if (threads == max_threads) {
+            break;
+        }
+    }
+    int chosen_threads = best.threads;
+    int chunk_count = (int)(sizeof(tuning_chunk_sizes) / sizeof(tuning_chunk_sizes[0]));
+    for (int c = 0; chosen_threads > 1 && c < chunk_count; ++c) {
+        if (tuning_chunk_sizes[c] != chunk_size) {
+            try_candidate(world, &saved, trial_steps, chosen_threads, tuning_chunk_sizes[c], specialized, &best);
+        }
+    }
+    if (specialized && select_kernels(&world->params, 1) != &generic_kernels) {
+        try_candidate(world, &saved, trial_steps, best.threads, best.chunk_size, 0, &best);
+    }
+
+    int ok = best.candidates > 0 && restart_pool(world, best.threads, best.chunk_size);
+    if (ok) {
+        use_kernels(world, best.specialized);
+    } else {
+        fprintf(stderr, "Could not start the worker threads while tuning\n");
+        use_kernels(world, specialized);
+    }
+    restore_snapshot(world, &saved.state);
+    world->step = saved.step;
+    world->state_version++;
+    memcpy(world->phase_time_ns, saved.phase_time_ns, sizeof(world->phase_time_ns));
+    world->observers = saved.observers;
+    clear_events(world);
+    world->validation_mode = saved.validation_mode;
+    world->rewind.arena = saved.rewind_arena;
+    free_snapshot(&saved.state);
+    if (ok && result != NULL) {
+        *result = best;
+    }
+    return ok;
+}
+
+// Applies a configuration chosen by world_autotune, e.g. one cached from an earlier run, between
+// steps; returns 0 (after printing why) if it is invalid or the worker threads cannot be started
+int world_apply_tuning(World* world, const TuningResult* tuning) {
+    if (tuning->threads < 1 || tuning->threads > MAX_THREADS || tuning->chunk_size < 1) {
+        fprintf(stderr, "Tuning needs 1 to %d threads and a chunk size of at least 1\n", MAX_THREADS);
+        return 0;
+    }
+    if (!restart_pool(world, tuning->threads, tuning->chunk_size)) {
+        fprintf(stderr, "Could not start %d worker threads; running on one\n", tuning->threads);
+        return 0;
+    }
+    use_kernels(world, tuning->specialized);
+    return 1;
+}
@@ -0,0 +1,259 @@
+#include <stdio.h>    // For checkpoint files (fopen, fprintf, fscanf)
+#include <stdlib.h>   // For free
+#include <string.h>   // For strcmp
+
+#include "alife_internal.h"
+
+// --- Checkpoints ---
+// A checkpoint is a text file holding everything needed to continue a run exactly: the seed the
+// run started from, the step, the generator state, the array capacities, the world parameters, the
+// ecology and every life form and food source. Floating-point values are written as hex floats (%a)
+// so they round-trip bit for bit. Version 1 files have no params line and load with the default
+// parameters; version 1 and 2 files have no ecology line and load with the default ecology.
+// Energies are stored lazily (see LifeForm), so from version 4 each life form carries the step count
+// its energy was stored at; older files hold energies as of the checkpoint's step. From version 5 the
+// ecology includes the food field rates and a field line gives the food field's size (0 0 with point
+// food); its densities follow the food sources, one line per row. Older files load with point food.
+// From version 6 the field line also names the food model, since a world with point food has a grid
+// too if it has scent; a scent line gives the number of scent fields, each with its rates on a line,
+// and the scent grids follow the densities, one after another, one line per row. Older files load
+// without scent. From version 7 the ecology ends with the range offspring speed factors are clamped
+// to; older files load with the default range.
+//
+//   ALIFE-CHECKPOINT 7
+//   seed <seed> step <step> rng <state>
+//   capacity <max life forms> <max food sources>
+//   params <width> <height> <life form radius> <food radius> <sense radius> <boundary> <sensing>
+//   ecology <reproduction threshold> <energy loss> <energy gain> <mutation width> <food respawn chance>
+//           <field regrowth> <field diffusion> <field graze> <min speed factor> <max speed factor>
+//   field <food model> <columns> <rows>                                       (0 0 without any field)
+//   scent <count>
+//   <deposit> <decay> <diffusion> <attraction>                                 (one line per scent field)
+//   life_forms <count>
+//   <x> <y> <vx> <vy> <energy> <speed_factor> <id> <r> <g> <b> <energy step>   (one line per life form)
+//   food <count>
+//   <x> <y> <is_present>                                                       (one line per food source)
+//   <density> ... <density>                                                    (one line per field row)
+//   <scent> ... <scent>                                                        (one line per scent row)
+
+// Saves the world's state to path; returns 0 on failure
+int world_save_checkpoint(const World* world, const char* path) {
+    FILE* f = fopen(path, "w");
+    if (f == NULL) {
+        fprintf(stderr, "Could not write checkpoint %s\n", path);
+        return 0;
+    }
+    fprintf(f, "%s %d\n", CHECKPOINT_MAGIC, CHECKPOINT_VERSION);
+    fprintf(f, "seed %llu step %lld rng %llx\n", world->seed, world->step, world->rng_state);
+    fprintf(f, "capacity %d %d\n", world->max_life_forms, world->max_food_sources);
+    const WorldParams* params = &world->params;
+    fprintf(f, "params %a %a %a %a %a %s %s\n", params->width, params->height, params->life_form_radius,
+            params->food_radius, params->sense_radius, boundary_policy_name(params->boundary),
+            sensing_mode_name(params->sensing));
+    const EcologyParams* ecology = &world->ecology;
+    fprintf(f, "ecology %a %a %a %a %a %a %a %a %a %a\n", ecology->reproduction_threshold, ecology->energy_loss,
+            ecology->energy_gain, ecology->mutation_width, ecology->food_respawn_chance, ecology->field_regrowth,
+            ecology->field_diffusion, ecology->field_graze, ecology->min_speed_factor, ecology->max_speed_factor);
+    const FoodField* field = &world->field;
+    const ScentFields* scent = &world->scent;
+    int columns = field->cells != NULL ? field->columns : scent->count > 0 ? scent->columns : 0;
+    int rows = field->cells != NULL ? field->rows : scent->count > 0 ? scent->rows : 0;
+    fprintf(f, "field %s %d %d\n", food_model_name(world->food_model), columns, rows);
+    fprintf(f, "scent %d\n", scent->count);
+    for (int i = 0; i < scent->count; ++i) {
+        const ScentParams* rates = &ecology->scent[i];
+        fprintf(f, "%a %a %a %a\n", rates->deposit, rates->decay, rates->diffusion, rates->attraction);
+    }
+    fprintf(f, "life_forms %d\n", world->life_form_count);
+    for (int i = 0; i < world->life_form_count; ++i) {
+        const LifeForm* lf = &world->life_forms[i];
+        fprintf(f, "%a %a %a %a %a %a %d %d %d %d %lld\n", lf->x, lf->y, lf->vx, lf->vy, lf->energy,
+                lf->speed_factor, lf->id, lf->r, lf->g, lf->b, lf->energy_step);
+    }
+    fprintf(f, "food %d\n", world->food_count);
+    for (int i = 0; i < world->food_count; ++i) {
+        const Food* food = &world->food_sources[i];
+        fprintf(f, "%a %a %d\n", food->x, food->y, food->is_present);
+    }
+    for (int i = 0; field->cells != NULL && i < columns * rows; ++i) {
+        fprintf(f, "%a%c", (double)field->cells[i], (i + 1) % columns == 0 ? '\n' : ' ');
+    }
+    for (int index = 0; index < scent->count; ++index) {
+        const float* cells = scent->cells + index * grid_cells(columns, rows);
+        for (int i = 0; i < columns * rows; ++i) {
+            fprintf(f, "%a%c", (double)cells[i], (i + 1) % columns == 0 ? '\n' : ' ');
+        }
+    }
+    int ok = !ferror(f);
+    if (fclose(f) != 0 || !ok) {
+        fprintf(stderr, "Could not write checkpoint %s\n", path);
+        return 0;
+    }
+    return 1;
+}
+
+// Creates a world from the checkpoint at path. Capacities, params, ecology, seed and state come from the
+// file; config only supplies the threading options, whether to specialize and the engine. Returns NULL on failure.
+World* world_load_checkpoint(const char* path, const WorldConfig* config) {
+    FILE* f = fopen(path, "r");
+    if (f == NULL) {
+        fprintf(stderr, "Could not open checkpoint %s\n", path);
+        return NULL;
+    }
+    char magic[32];
+    int version = 0;
+    unsigned long long seed = 0;
+    long long step = 0;
+    unsigned long long rng_state = 0;
+    WorldConfig file_config = *config;
+    World* world = NULL;
+    char boundary[16];
+    char sensing[16];
+    default_world_params(&file_config.params);
+    default_ecology_params(&file_config.ecology);
+    int ok = fscanf(f, "%31s %d", magic, &version) == 2 && strcmp(magic, CHECKPOINT_MAGIC) == 0
+             && version >= 1 && version <= CHECKPOINT_VERSION
+             && fscanf(f, " seed %llu step %lld rng %llx", &seed, &step, &rng_state) == 3
+             && fscanf(f, " capacity %d %d", &file_config.max_life_forms, &file_config.max_food_sources) == 2
+             && file_config.max_life_forms > 0 && file_config.max_food_sources > 0;
+    if (ok && version >= 2) {
+        WorldParams* params = &file_config.params;
+        ok = fscanf(f, " params %la %la %la %la %la %15s %15s", &params->width, &params->height,
+                    &params->life_form_radius, &params->food_radius, &params->sense_radius, boundary, sensing) == 7
+             && parse_boundary_policy(boundary) >= 0 && parse_sensing_mode(sensing) >= 0;
+        if (ok) {
+            params->boundary = (BoundaryPolicy)parse_boundary_policy(boundary);
+            params->sensing = (SensingMode)parse_sensing_mode(sensing);
+        }
+    }
+    if (ok && version >= 3) {
+        EcologyParams* ecology = &file_config.ecology;
+        ok = fscanf(f, " ecology %la %la %la %la %la", &ecology->reproduction_threshold, &ecology->energy_loss,
+                    &ecology->energy_gain, &ecology->mutation_width, &ecology->food_respawn_chance) == 5;
+    }
+    file_config.food_model = FOOD_POINTS;
+    file_config.scent_fields = 0;
+    if (ok && version == 5) {
+        EcologyParams* ecology = &file_config.ecology;
+        ok = fscanf(f, "%la %la %la", &ecology->field_regrowth, &ecology->field_diffusion, &ecology->field_graze) == 3
+             && fscanf(f, " field %d %d", &file_config.field_columns, &file_config.field_rows) == 2;
+        file_config.food_model = file_config.field_columns > 0 ? FOOD_FIELD : FOOD_POINTS;
+    } else if (ok && version >= 6) {
+        EcologyParams* ecology = &file_config.ecology;
+        char food_model[16];
+        ok = fscanf(f, "%la %la %la", &ecology->field_regrowth, &ecology->field_diffusion, &ecology->field_graze) == 3
+             && (version < 7
+                 || fscanf(f, "%la %la", &ecology->min_speed_factor, &ecology->max_speed_factor) == 2)
+             && fscanf(f, " field %15s %d %d", food_model, &file_config.field_columns, &file_config.field_rows) == 3
+             && parse_food_model(food_model) >= 0
+             && fscanf(f, " scent %d", &file_config.scent_fields) == 1
+             && file_config.scent_fields >= 0 && file_config.scent_fields <= MAX_SCENT_FIELDS;
+        if (ok) {
+            file_config.food_model = (FoodModel)parse_food_model(food_model);
+        }
+        for (int i = 0; ok && i < file_config.scent_fields; ++i) {
+            ScentParams* rates = &ecology->scent[i];
+            ok = fscanf(f, "%la %la %la %la", &rates->deposit, &rates->decay, &rates->diffusion,
+                        &rates->attraction) == 4;
+        }
+    }
+    if (ok) {
+        world = world_allocate(&file_config);
+        ok = world != NULL;
+    }
+    ok = ok && fscanf(f, " life_forms %d", &world->life_form_count) == 1
+         && world->life_form_count >= 0 && world->life_form_count <= world->max_life_forms;
+    for (int i = 0; ok && i < world->life_form_count; ++i) {
+        LifeForm* lf = &world->life_forms[i];
+        unsigned int r, g, b;
+        ok = fscanf(f, "%la %la %la %la %la %la %d %u %u %u", &lf->x, &lf->y, &lf->vx, &lf->vy, &lf->energy,
+                    &lf->speed_factor, &lf->id, &r, &g, &b) == 10;
+        lf->r = (unsigned char)r;
+        lf->g = (unsigned char)g;
+        lf->b = (unsigned char)b;
+        lf->energy_step = step;
+        if (ok && version >= 4) {
+            ok = fscanf(f, "%lld", &lf->energy_step) == 1 && lf->energy_step <= step;
+        }
+        if (ok) {
+            predict_death(world, lf);
+        }
+    }
+    ok = ok && fscanf(f, " food %d", &world->food_count) == 1
+         && world->food_count >= 0 && world->food_count <= world->max_food_sources;
+    for (int i = 0; ok && i < world->food_count; ++i) {
+        Food* food = &world->food_sources[i];
+        ok = fscanf(f, "%la %la %d", &food->x, &food->y, &food->is_present) == 3;
+    }
+    for (int i = 0; ok && world->field.cells != NULL && i < world->field.columns * world->field.rows; ++i) {
+        double density;
+        ok = fscanf(f, "%la", &density) == 1;
+        world->field.cells[i] = (float)density;
+    }
+    for (int index = 0; ok && index < world->scent.count; ++index) {
+        float* cells = world->scent.cells + index * grid_cells(world->scent.columns, world->scent.rows);
+        for (int i = 0; ok && i < world->scent.columns * world->scent.rows; ++i) {
+            double value;
+            ok = fscanf(f, "%la", &value) == 1;
+            cells[i] = (float)value;
+        }
+    }
+    fclose(f);
+
+    if (!ok) {
+        fprintf(stderr, "Checkpoint %s is not a valid version 1 to %d checkpoint\n", path, CHECKPOINT_VERSION);
+        world_destroy(world);
+        return NULL;
+    }
+    world->seed = seed;
+    world->step = step;
+    world->rng_state = rng_state;
+    return world;
+}
+
+// Mixes len bytes into a 64-bit FNV-1a hash
+unsigned long long hash_bytes(unsigned long long hash, const void* data, size_t len) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < len; ++i) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+// Returns a hash of everything a checkpoint holds except the seed and step, so that two runs
+// can be compared step by step without writing checkpoints. Fields are hashed one by one
+// because struct padding is not part of the state.
+unsigned long long world_state_hash(const World* world) {
+    unsigned long long hash = 0xCBF29CE484222325ULL;
+    hash = hash_bytes(hash, &world->rng_state, sizeof(world->rng_state));
+    hash = hash_bytes(hash, &world->life_form_count, sizeof(world->life_form_count));
+    for (int i = 0; i < world->life_form_count; ++i) {
+        const LifeForm* lf = &world->life_forms[i];
+        hash = hash_bytes(hash, &lf->x, sizeof(lf->x));
+        hash = hash_bytes(hash, &lf->y, sizeof(lf->y));
+        hash = hash_bytes(hash, &lf->vx, sizeof(lf->vx));
+        hash = hash_bytes(hash, &lf->vy, sizeof(lf->vy));
+        hash = hash_bytes(hash, &lf->energy, sizeof(lf->energy));
+        hash = hash_bytes(hash, &lf->energy_step, sizeof(lf->energy_step));
+        hash = hash_bytes(hash, &lf->speed_factor, sizeof(lf->speed_factor));
+        hash = hash_bytes(hash, &lf->id, sizeof(lf->id));
+        hash = hash_bytes(hash, &lf->r, sizeof(lf->r));
+        hash = hash_bytes(hash, &lf->g, sizeof(lf->g));
+        hash = hash_bytes(hash, &lf->b, sizeof(lf->b));
+    }
+    hash = hash_bytes(hash, &world->food_count, sizeof(world->food_count));
+    for (int i = 0; i < world->food_count; ++i) {
+        const Food* food = &world->food_sources[i];
+        hash = hash_bytes(hash, &food->x, sizeof(food->x));
+        hash = hash_bytes(hash, &food->y, sizeof(food->y));
+        hash = hash_bytes(hash, &food->is_present, sizeof(food->is_present));
+    }
+    if (world->field.cells != NULL) {
+        hash = hash_bytes(hash, world->field.cells, (size_t)world->field.columns * world->field.rows * sizeof(float));
+    }
+    for (int index = 0; index < world->scent.count; ++index) {
+        hash = hash_bytes(hash, world->scent.cells + index * grid_cells(world->scent.columns, world->scent.rows),
+                          (size_t)world->scent.columns * world->scent.rows * sizeof(float));
+    }
+    return hash;
+}
@@ -0,0 +1,232 @@
+#include <stdio.h>    // For error messages (fprintf)
+#include <stdlib.h>   // For malloc, free (sim_malloc, sim_free)
+#include <math.h>     // For sqrt, fabs, INFINITY
+#include <limits.h>   // For LLONG_MAX (no death ahead)
+
+#include "alife_internal.h"
+
+// --- Event-Driven Engine ---
+// In a sparse world a life form goes many steps between events: food coming into sensing range, the
+// nearest food changing, food coming within reach, starving. The stepped engine searches all food
+// and checks every contact every step anyway. The event-driven engine works out for every life form
+// when its next food event can happen at the earliest and does the work only from then on.
+//
+// Positions still advance one step at a time, and wandering life forms still draw from the random
+// generator every step: a closed-form position would round differently from the repeated additions
+// of the stepped engine, and the draws of all life forms share one generator in a fixed order. Only
+// the searches and checks are scheduled, with bounds that hold for every step a life form can take,
+// so the two engines reach the same state bit for bit; validation compares them phase by phase.
+
+// Allocates the schedule arrays at the world's capacities; returns 0 (after printing why) on failure
+int allocate_schedules(World* world) {
+    world->schedules = (FoodSchedule*)sim_malloc(world->max_life_forms * sizeof(FoodSchedule));
+    world->next_schedules = (FoodSchedule*)sim_malloc(world->max_life_forms * sizeof(FoodSchedule));
+    world->food_remap = (int*)sim_malloc(world->max_food_sources * sizeof(int));
+    world->schedule_version = -1;
+    if (world->schedules == NULL || world->next_schedules == NULL || world->food_remap == NULL) {
+        fprintf(stderr, "Memory allocation failed for the event schedules!\n");
+        free_schedules(world);
+        return 0;
+    }
+    return 1;
+}
+
+void free_schedules(World* world) {
+    sim_free(world->schedules);
+    sim_free(world->next_schedules);
+    sim_free(world->food_remap);
+    world->schedules = world->next_schedules = NULL;
+    world->food_remap = NULL;
+}
+
+// --- Bounds ---
+
+// Safety margin of every distance bound: far above the rounding error of a distance in the world
+static double schedule_margin(const World* world) {
+    return SCHEDULE_SLACK * (world->params.width + world->params.height);
+}
+
+// Whole steps for which a gap closing by at most closing per step is certain to stay positive
+static long long steps_open(double gap, double closing) {
+    double steps = gap / closing;
+    if (!(steps > 0)) {
+        return 0;
+    }
+    return steps < SCHEDULE_HORIZON ? (long long)steps : SCHEDULE_HORIZON;
+}
+
+// Distance from lf to (x, y); across the edges on a torus
+static double distance_to(const World* world, const LifeForm* lf, double x, double y) {
+    double dx = fabs(x - lf->x);
+    double dy = fabs(y - lf->y);
+    if (world->params.boundary == BOUNDARY_WRAP) {
+        if (dx > world->params.width * 0.5) dx = world->params.width - dx;
+        if (dy > world->params.height * 0.5) dy = world->params.height - dy;
+    }
+    return sqrt(dx * dx + dy * dy);
+}
+
+// Sets schedule->search_until from its distances: the first step at which another food could be
+// nearest, the target could leave sensing range, or food could come into it
+static void schedule_search_end(const World* world, FoodSchedule* schedule) {
+    double margin = schedule_margin(world);
+    long long steps;
+    if (schedule->target != -1) {
+        steps = steps_open(schedule->second - schedule->nearest - margin, 2.0 * schedule->reach);
+        if (world->params.sensing == SENSE_LOCAL) {
+            long long in_range = steps_open(world->params.sense_radius - schedule->nearest - margin, schedule->reach);
+            steps = in_range < steps ? in_range : steps;
+        }
+    } else if (world->params.sensing == SENSE_LOCAL) {
+        steps = steps_open(schedule->nearest - world->params.sense_radius - margin, schedule->reach);
+    } else {
+        steps = schedule->nearest == INFINITY ? SCHEDULE_HORIZON : 0; // No food at all, until some appears
+    }
+    schedule->search_until = schedule->searched + (steps > 1 ? steps : 1);
+}
+
+// Records a food search lf just ran: its target and the squared distances to the nearest and second
+// nearest present food
+void schedule_food_search(const World* world, const LifeForm* lf, FoodSchedule* schedule, int target,
+                          double nearest_sq, double second_sq) {
+    // Velocities only ever change to at most MAX_SPEED * speed_factor; the current one may be faster
+    double speed = sqrt(lf->vx * lf->vx + lf->vy * lf->vy);
+    double max_speed = MAX_SPEED * lf->speed_factor;
+    schedule->reach = (speed > max_speed ? speed : max_speed) * (1.0 + SCHEDULE_SLACK) + schedule_margin(world);
+    schedule->searched = world->step;
+    schedule->target = target;
+    schedule->nearest = sqrt(nearest_sq);
+    schedule->second = sqrt(second_sq);
+    schedule_search_end(world, schedule);
+    schedule_contact(world, schedule, nearest_sq);
+}
+
+// Sets the first step a life form may touch food, from the squared distance to the nearest present food now
+void schedule_contact(const World* world, FoodSchedule* schedule, double nearest_sq) {
+    double reach_radius = world->params.life_form_radius + world->params.food_radius;
+    schedule->contact_from = world->step + steps_open(sqrt(nearest_sq) - reach_radius - schedule_margin(world),
+                                                      schedule->reach);
+}
+
+// Brings the schedules of every life form up to date for food that just appeared at index food
+void schedule_new_food(World* world, int food) {
+    double x = world->food_sources[food].x;
+    double y = world->food_sources[food].y;
+    double reach_radius = world->params.life_form_radius + world->params.food_radius;
+    double margin = schedule_margin(world);
+    for (int i = 0; i < world->life_form_count; ++i) {
+        FoodSchedule* schedule = &world->schedules[i];
+        double distance = distance_to(world, &world->life_forms[i], x, y);
+        long long contact = world->step + steps_open(distance - reach_radius - margin, schedule->reach);
+        if (contact < schedule->contact_from) {
+            schedule->contact_from = contact;
+        }
+        // Where the life form was at the search, the food was at least this far away
+        double from_search = distance - (double)(world->step - schedule->searched) * schedule->reach;
+        if (schedule->target == -1) {
+            schedule->nearest = from_search < schedule->nearest ? from_search : schedule->nearest;
+        } else {
+            schedule->second = from_search < schedule->second ? from_search : schedule->second;
+        }
+        schedule_search_end(world, schedule);
+    }
+}
+
+// Follows the food array's compaction (food_remap); life forms whose target was eaten search again
+void schedule_food_compaction(World* world) {
+    for (int i = 0; i < world->life_form_count; ++i) {
+        FoodSchedule* schedule = &world->schedules[i];
+        if (schedule->target != -1) {
+            schedule->target = world->food_remap[schedule->target];
+            if (schedule->target == -1) {
+                schedule->search_until = world->step + 1;
+            }
+        }
+    }
+}
+
+// --- Phases ---
+
+// Starts an event-driven step. Schedules hold only while nothing but this engine's steps changed the
+// entities (state_version); otherwise every life form searches and checks again, and the
+// reproduction pass runs. Under tolerance validation the step goes on from the reference result,
+// which may differ slightly from the state the schedules were made for, so they are not kept.
+void begin_event_step(World* world) {
+    if (world->schedule_version == world->state_version && world->validation_mode != VALIDATE_TOLERANCE) {
+        return;
+    }
+    for (int i = 0; i < world->life_form_count; ++i) {
+        world->schedules[i].search_until = 0;
+        world->schedules[i].contact_from = 0;
+        world->schedules[i].target = -1;
+    }
+    world->reproduce_due = 1;
+}
+
+// Carries the schedules of the survivors among the first parents life forms of the generation
+// reproduce_life_forms just replaced (now world->next_life_forms) over to their new places.
+// The new generation holds the survivors in order, then the offspring, which have no schedule yet;
+// a life form survives when its predicted death is still ahead, which halving a parent's energy
+// never changes.
+static void carry_schedules(World* world, int parents) {
+    long long clock = energy_clock(world);
+    const LifeForm* previous = world->next_life_forms;
+    int kept = 0;
+    for (int i = 0; i < parents; ++i) {
+        if (clock < previous[i].death_step) {
+            world->next_schedules[kept++] = world->schedules[i];
+        }
+    }
+    for (; kept < world->life_form_count; ++kept) {
+        world->next_schedules[kept].search_until = 0;
+        world->next_schedules[kept].contact_from = 0;
+        world->next_schedules[kept].target = -1;
+    }
+    FoodSchedule* temp_schedules = world->next_schedules;
+    world->next_schedules = world->schedules;
+    world->schedules = temp_schedules;
+}
+
+// 3. Reproduction and death, only in steps where some life form can reproduce or die. Energy only
+// rises by feeding, so after a pass in which no life form was left ready to reproduce, none is
+// until the next feeding; deaths are predicted (LifeForm.death_step).
+void event_reproduce_phase(World* world) {
+    long long clock = energy_clock(world);
+    if (world->reproduce_due || clock >= world->next_death) {
+        int parents = world->life_form_count;
+        reproduce_life_forms(world);
+        carry_schedules(world, parents);
+        world->reproduce_due = 0;
+        world->next_death = LLONG_MAX;
+        for (int i = 0; i < world->life_form_count; ++i) {
+            const LifeForm* lf = &world->life_forms[i];
+            if (lf->death_step < world->next_death) {
+                world->next_death = lf->death_step;
+            }
+            if (life_form_energy_at(world, lf, clock) >= world->ecology.reproduction_threshold) {
+                world->reproduce_due = 1;
+            }
+        }
+    }
+    // world_step advances state_version once per step; any other change invalidates the schedules
+    world->schedule_version = world->state_version + 1;
+}
+
+// --- Engine API ---
+
+// Selects the engine of the next steps; returns 0 (after printing why) if engine is invalid
+int world_set_engine(World* world, EngineKind engine) {
+    if (engine < ENGINE_STEPPED || engine >= ENGINE_COUNT) {
+        fprintf(stderr, "Unknown engine %d\n", (int)engine);
+        return 0;
+    }
+    if (engine != world->engine) {
+        world->engine = engine;
+        world->schedule_version = -1; // The stepped engine keeps no schedules
+    }
+    return 1;
+}
+
+EngineKind world_engine(const World* world) {
+    return world->engine;
+}
@@ -0,0 +1,283 @@
+#include <stdio.h>    // For error messages (fprintf)
+#include <stdlib.h>   // For malloc, free (sim_malloc, sim_free)
+#include <string.h>   // For memset
+
+#include "alife_internal.h"
+
+// --- Food and Scent Fields ---
+// A FOOD_FIELD world's food is a grid of densities (FoodField), and any world can have scent grids
+// of the same size (ScentFields). Life forms graze, steer and follow scent in the field kernels
+// (kernel_template.h); this file keeps the grids themselves and updates them once per step.
+
+// Returns 0 (after printing why) if config's food model, scent fields or field size is invalid
+int check_field_config(const WorldConfig* config) {
+    if (config->food_model < FOOD_POINTS || config->food_model >= FOOD_MODEL_COUNT) {
+        fprintf(stderr, "Unknown food model %d\n", (int)config->food_model);
+        return 0;
+    }
+    if (config->scent_fields < 0 || config->scent_fields > MAX_SCENT_FIELDS) {
+        fprintf(stderr, "A world can have 0 to %d scent fields\n", MAX_SCENT_FIELDS);
+        return 0;
+    }
+    if ((config->food_model == FOOD_FIELD || config->scent_fields > 0)
+        && (config->field_columns < 1 || config->field_columns > MAX_FIELD_CELLS
+            || config->field_rows < 1 || config->field_rows > MAX_FIELD_CELLS)) {
+        fprintf(stderr, "Food and scent fields need 1 to %d columns and rows\n", MAX_FIELD_CELLS);
+        return 0;
+    }
+    return 1;
+}
+
+// Allocates an empty field of columns x rows cells; returns 0 (after printing why) on failure
+int allocate_field(World* world, int columns, int rows) {
+    world->field.columns = columns;
+    world->field.rows = rows;
+    size_t cells = grid_cells(columns, rows); // The padding stays zero in both buffers
+    world->field.cells = (float*)sim_malloc(cells * sizeof(float));
+    world->field.next = (float*)sim_malloc(cells * sizeof(float));
+    if (world->field.cells == NULL || world->field.next == NULL) {
+        fprintf(stderr, "Memory allocation failed for the food field!\n");
+        free_field(world);
+        return 0;
+    }
+    memset(world->field.cells, 0, cells * sizeof(float));
+    memset(world->field.next, 0, cells * sizeof(float));
+    return 1;
+}
+
+void free_field(World* world) {
+    sim_free(world->field.cells);
+    sim_free(world->field.next);
+    world->field.cells = world->field.next = NULL;
+}
+
+// Allocates count scent grids of columns x rows cells, all without scent, and the deposit cells;
+// returns 0 (after printing why) on failure
+int allocate_scent(World* world, int count, int columns, int rows) {
+    world->scent.count = count;
+    world->scent.columns = columns;
+    world->scent.rows = rows;
+    if (count == 0) {
+        return 1;
+    }
+    world->scent.cells = (float*)sim_malloc(scent_bytes(world));
+    world->scent.next = (float*)sim_malloc(scent_bytes(world));
+    world->scent.deposit_cells = (int*)sim_malloc(world->max_life_forms * sizeof(int));
+    if (world->scent.cells == NULL || world->scent.next == NULL || world->scent.deposit_cells == NULL) {
+        fprintf(stderr, "Memory allocation failed for the scent fields!\n");
+        free_scent(world);
+        return 0;
+    }
+    memset(world->scent.cells, 0, scent_bytes(world));
+    memset(world->scent.next, 0, scent_bytes(world));
+    return 1;
+}
+
+void free_scent(World* world) {
+    sim_free(world->scent.cells);
+    sim_free(world->scent.next);
+    sim_free(world->scent.deposit_cells);
+    world->scent.cells = world->scent.next = NULL;
+    world->scent.deposit_cells = NULL;
+    world->scent.count = 0;
+}
+
+// Gives every cell a random density, so the field is patchy from the start
+void initialize_field(World* world) {
+    for (int i = 0; i < world->field.columns * world->field.rows; ++i) {
+        world->field.cells[i] = (float)random_unit(world);
+    }
+}
+
+// --- Stencil ---
+// Every cell exchanges diffusion of its difference with each of its four neighbours (five-point
+// stencil), then regrows regrowth of what it lacks and loses decay of what it has: the food field
+// regrows and does not decay, scent decays and does not regrow (a zero rate leaves a cell's value
+// exactly as it was). Neighbours wrap around on a torus; at a bouncing wall a cell is its own
+// neighbour, so nothing flows through the wall. The optimized and reference versions below compute
+// every cell with cell_update, so they agree bit for bit; validation compares them. Every cell
+// only depends on the old grid, so blocks of rows are updated on the worker pool in any order.
+
+// New value of a cell from its own and its neighbours' values
+static inline float cell_update(float c, float up, float down, float left, float right, float diffusion,
+                                float regrowth, float decay) {
+    float d = c + diffusion * (((up + down) + (left + right)) - 4.0f * c);
+    d = d + regrowth * (1.0f - d);
+    return d - decay * d;
+}
+
+// One row from the rows above and below it (mid itself at a bouncing wall). The interior columns
+// have no edge cases and the rows do not overlap out, so the compiler vectorizes that loop.
+static void update_row(const float* restrict up, const float* restrict mid, const float* restrict down,
+                       float* restrict out, int columns, int wrap, float diffusion, float regrowth, float decay) {
+    int last = columns - 1;
+    if (columns == 1) {
+        out[0] = cell_update(mid[0], up[0], down[0], mid[0], mid[0], diffusion, regrowth, decay);
+        return;
+    }
+    out[0] = cell_update(mid[0], up[0], down[0], wrap ? mid[last] : mid[0], mid[1], diffusion, regrowth, decay);
+    for (int x = 1; x < last; ++x) {
+        out[x] = cell_update(mid[x], up[x], down[x], mid[x - 1], mid[x + 1], diffusion, regrowth, decay);
+    }
+    out[last] = cell_update(mid[last], up[last], down[last], mid[last - 1], wrap ? mid[0] : mid[last], diffusion,
+                            regrowth, decay);
+}
+
+// Rows [begin, end) of a columns x rows grid from cells into next (optimized kernel)
+static void update_rows(const float* cells, float* next, int columns, int rows, int begin, int end, int wrap,
+                        float diffusion, float regrowth, float decay) {
+    for (int y = begin; y < end; ++y) {
+        const float* mid = cells + (size_t)y * columns;
+        const float* up = y > 0 ? mid - columns : wrap ? cells + (size_t)(rows - 1) * columns : mid;
+        const float* down = y < rows - 1 ? mid + columns : wrap ? cells : mid;
+        update_row(up, mid, down, next + (size_t)y * columns, columns, wrap, diffusion, regrowth, decay);
+    }
+}
+
+// A whole columns x rows grid from cells into next, one cell at a time with its neighbours' indices
+// (reference kernel)
+static void update_grid_reference(const float* cells, float* next, int columns, int rows, int wrap,
+                                  float diffusion, float regrowth, float decay) {
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < columns; ++x) {
+            int i = y * columns + x;
+            int left = x > 0 ? i - 1 : wrap ? i + columns - 1 : i;
+            int right = x < columns - 1 ? i + 1 : wrap ? i - x : i;
+            int up = y > 0 ? i - columns : wrap ? i + (rows - 1) * columns : i;
+            int down = y < rows - 1 ? i + columns : wrap ? x : i;
+            next[i] = cell_update(cells[i], cells[up], cells[down], cells[left], cells[right], diffusion, regrowth,
+                                  decay);
+        }
+    }
+}
+
+// Work item of the food field's stencil: rows [begin, end)
+static void food_field_rows(World* world, int begin, int end) {
+    FoodField* field = &world->field;
+    update_rows(field->cells, field->next, field->columns, field->rows, begin, end,
+                world->params.boundary == BOUNDARY_WRAP, (float)world->ecology.field_diffusion,
+                (float)world->ecology.field_regrowth, 0.0f);
+}
+
+// Work item of the scent stencil: rows [begin, end) of all scent grids, numbered one grid after another
+static void scent_rows(World* world, int begin, int end) {
+    ScentFields* scent = &world->scent;
+    size_t stride = grid_cells(scent->columns, scent->rows);
+    while (begin < end) {
+        int index = begin / scent->rows;
+        int grid_end = (index + 1) * scent->rows < end ? (index + 1) * scent->rows : end;
+        const ScentParams* params = &world->ecology.scent[index];
+        update_rows(scent->cells + index * stride, scent->next + index * stride, scent->columns, scent->rows,
+                    begin - index * scent->rows, grid_end - index * scent->rows,
+                    world->params.boundary == BOUNDARY_WRAP, (float)params->diffusion, 0.0f, (float)params->decay);
+        begin = grid_end;
+    }
+}
+
+// Runs task over rows rows of grids of cells cells in all, in blocks of FIELD_BLOCK_ROWS on the
+// worker pool if the grids are large enough to pay for waking it
+static void run_rows(World* world, int rows, size_t cells, void (*task)(World* world, int begin, int end)) {
+    if (world->pool.worker_count > 0 && cells >= FIELD_PARALLEL_CELLS) {
+        parallel_for_blocks(world, rows, FIELD_BLOCK_ROWS, task);
+    } else {
+        task(world, 0, rows);
+    }
+}
+
+// Regrows and diffuses the field (optimized kernel)
+void step_food_field(World* world) {
+    FoodField* field = &world->field;
+    run_rows(world, field->rows, (size_t)field->columns * field->rows, food_field_rows);
+    float* swap = field->cells;
+    field->cells = field->next;
+    field->next = swap;
+}
+
+// Regrows and diffuses the field (reference kernel)
+void step_food_field_reference(World* world) {
+    FoodField* field = &world->field;
+    update_grid_reference(field->cells, field->next, field->columns, field->rows,
+                          world->params.boundary == BOUNDARY_WRAP, (float)world->ecology.field_diffusion,
+                          (float)world->ecology.field_regrowth, 0.0f);
+    float* swap = field->cells;
+    field->cells = field->next;
+    field->next = swap;
+}
+
+// Adds every life form's deposit to the cell follow_scent_range recorded for it. Each life form
+// writes only its own deposit cell, so the update phase needs no atomics; adding the deposits up
+// here, in life form order, makes every grid the same whatever the threads and their chunks.
+void deposit_scent(World* world) {
+    ScentFields* scent = &world->scent;
+    size_t stride = grid_cells(scent->columns, scent->rows);
+    for (int index = 0; index < scent->count; ++index) {
+        float* cells = scent->cells + index * stride;
+        float deposit = (float)world->ecology.scent[index].deposit;
+        for (int i = 0; i < world->life_form_count; ++i) {
+            cells[scent->deposit_cells[i]] += deposit;
+        }
+    }
+}
+
+// Diffuses and decays every scent grid (optimized kernel)
+void step_scent(World* world) {
+    ScentFields* scent = &world->scent;
+    run_rows(world, scent->count * scent->rows, (size_t)scent->count * scent->columns * scent->rows, scent_rows);
+    float* swap = scent->cells;
+    scent->cells = scent->next;
+    scent->next = swap;
+}
+
+// Diffuses and decays every scent grid (reference kernel)
+void step_scent_reference(World* world) {
+    ScentFields* scent = &world->scent;
+    size_t stride = grid_cells(scent->columns, scent->rows);
+    for (int index = 0; index < scent->count; ++index) {
+        const ScentParams* params = &world->ecology.scent[index];
+        update_grid_reference(scent->cells + index * stride, scent->next + index * stride, scent->columns,
+                              scent->rows, world->params.boundary == BOUNDARY_WRAP, (float)params->diffusion, 0.0f,
+                              (float)params->decay);
+    }
+    float* swap = scent->cells;
+    scent->cells = scent->next;
+    scent->next = swap;
+}
+
+// --- Food Field API ---
+
+FoodModel world_food_model(const World* world) {
+    return world->food_model;
+}
+
+void world_field_size(const World* world, int* columns, int* rows) {
+    *columns = world->field.cells != NULL ? world->field.columns : 0;
+    *rows = world->field.cells != NULL ? world->field.rows : 0;
+}
+
+const float* world_field(const World* world) {
+    return world->field.cells;
+}
+
+double world_field_total(const World* world) {
+    double total = 0.0;
+    for (int i = 0; world->field.cells != NULL && i < world->field.columns * world->field.rows; ++i) {
+        total += world->field.cells[i];
+    }
+    return total;
+}
+
+// --- Scent Field API ---
+
+int world_scent_fields(const World* world) {
+    return world->scent.count;
+}
+
+const float* world_scent(const World* world, int index, int* columns, int* rows) {
+    if (index < 0 || index >= world->scent.count) {
+        *columns = *rows = 0;
+        return NULL;
+    }
+    *columns = world->scent.columns;
+    *rows = world->scent.rows;
+    return world->scent.cells + index * grid_cells(world->scent.columns, world->scent.rows);
+}
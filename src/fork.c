@@ -0,0 +1,86 @@
+#include <stdio.h>    // For error messages (fprintf)
+#include <stdlib.h>   // For malloc, free (sim_malloc, sim_free)
+#include <string.h>   // For memset, memcpy
+
+#include "alife_internal.h"
+
+// --- Fork API ---
+
+// Creates a world in world's exact state that evolves independently from then on, with its own
+// pool of the given number of update threads; world must not be stepping meanwhile. The live
+// entities, field and scent are copied into arrays of the fork's own, so a fork costs time and
+// memory in proportion to the population. Returns NULL (after printing why) on failure.
+World* world_fork(const World* world, int threads) {
+    if (threads < 1 || threads > MAX_THREADS) {
+        fprintf(stderr, "Thread count must be between 1 and %d\n", MAX_THREADS);
+        return NULL;
+    }
+    World* fork = (World*)sim_malloc(sizeof(World));
+    if (fork == NULL) {
+        fprintf(stderr, "Memory allocation failed for the fork!\n");
+        return NULL;
+    }
+    memset(fork, 0, sizeof(World));
+    fork->max_life_forms = world->max_life_forms;
+    fork->max_food_sources = world->max_food_sources;
+    fork->life_form_count = world->life_form_count;
+    fork->food_count = world->food_count;
+    fork->rng_state = world->rng_state;
+    fork->seed = world->seed;
+    fork->step = world->step;
+    fork->state_version = world->state_version;
+    fork->params = world->params;
+    fork->ecology = world->ecology;
+    fork->kernels = world->kernels;
+    fork->specialized = world->specialized;
+    fork->engine = world->engine;
+    fork->food_model = world->food_model;
+    fork->pending_changes = world->pending_changes;
+    fork->pending_params = world->pending_params;
+    fork->pending_ecology = world->pending_ecology;
+
+    if (!allocate_entities(fork)) {
+        sim_free(fork);
+        return NULL;
+    }
+    memcpy(fork->life_forms, world->life_forms, world->life_form_count * sizeof(LifeForm));
+    memcpy(fork->food_sources, world->food_sources, world->food_count * sizeof(Food));
+    if (!allocate_schedules(fork)) { // Forks make their own schedules on their first step
+        release_entities(fork);
+        sim_free(fork);
+        return NULL;
+    }
+    if (world->field.cells != NULL) {
+        if (!allocate_field(fork, world->field.columns, world->field.rows)) {
+            free_schedules(fork);
+            release_entities(fork);
+            sim_free(fork);
+            return NULL;
+        }
+        memcpy(fork->field.cells, world->field.cells, field_bytes(world));
+    }
+    if (!allocate_scent(fork, world->scent.count, world->scent.columns, world->scent.rows)) {
+        free_field(fork);
+        free_schedules(fork);
+        release_entities(fork);
+        sim_free(fork);
+        return NULL;
+    }
+    if (world->scent.count > 0) {
+        memcpy(fork->scent.cells, world->scent.cells, scent_bytes(world));
+    }
+
+    // Forks are usually stepped on threads of their own, so their pools are never pinned
+    fork->pool.thread_count = threads;
+    fork->pool.chunk_size = world->pool.chunk_size;
+    fork->pool.pin_strategy = PIN_NONE;
+    if (!start_worker_pool(&fork->pool)) {
+        free_scent(fork);
+        free_field(fork);
+        free_schedules(fork);
+        release_entities(fork);
+        sim_free(fork);
+        return NULL;
+    }
+    return fork;
+}
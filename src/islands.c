@@ -0,0 +1,294 @@
+#define _GNU_SOURCE // For sched_yield
+#include <stdio.h>    // For error messages (fprintf)
+#include <stdlib.h>   // For malloc, free (sim_malloc, sim_free)
+#include <string.h>   // For memset
+#include <sched.h>    // For sched_yield
+
+#include "alife_internal.h"
+
+#define MIGRATION_QUEUE_DEPTH 4 // Migrations an island may send ahead of the one that takes them in
+#define WAIT_SPINS 100          // Yields before a waiting island blocks on its queue
+#define CACHE_LINE 64
+
+// --- Migrant Queues ---
+// Every island has one inbox, filled only by the island before it in the ring and emptied only
+// by itself: a single-producer, single-consumer ring of migrant batches, one per migration. The
+// producer publishes a batch by advancing head, the consumer frees its slot by advancing tail.
+// Islands wait only for a batch that is due or a slot that is still taken, so an island can run
+// up to MIGRATION_QUEUE_DEPTH migrations ahead of its neighbours. A waiting island yields a few
+// times, since its neighbour is usually about to arrive, then sleeps on the queue's condition
+// variable; the other side only takes the mutex to wake it when someone sleeps.
+
+// head and tail are a cache line apart, so the two islands do not contend for one line.
+typedef struct {
+    atomic_llong head; // Batches published (written by the producer)
+    char head_padding[CACHE_LINE - sizeof(atomic_llong)];
+    atomic_llong tail; // Batches taken in (written by the consumer)
+    char tail_padding[CACHE_LINE - sizeof(atomic_llong)];
+    int counts[MIGRATION_QUEUE_DEPTH];
+    LifeForm* slots; // MIGRATION_QUEUE_DEPTH batches of up to IslandConfig.migrants life forms
+    atomic_int sleepers; // Islands blocked in WAIT_WHILE on this queue
+    pthread_mutex_t mutex;
+    pthread_cond_t wake;
+} MigrantQueue;
+
+typedef struct {
+    World* world;
+    struct Archipelago* archipelago;
+    int index;
+    unsigned long long rng_state; // Chooses the emigrants, so the world's own generator is left alone
+    MigrantQueue inbox;           // From the island before
+    long long steps;              // Of the current archipelago_run
+    long long completed;
+    long long arrivals;           // Migrants taken in
+    pthread_t thread;
+} Island;
+
+struct Archipelago {
+    IslandConfig config;
+    PinStrategy pin;
+    Island* islands;
+    atomic_int aborted; // Set when an island stops early, so that none waits for it forever
+};
+
+// Fills islands with the defaults
+void archipelago_default_config(IslandConfig* islands) {
+    islands->islands = DEFAULT_ISLANDS;
+    islands->migration_interval = DEFAULT_MIGRATION_INTERVAL;
+    islands->migrants = DEFAULT_MIGRANTS;
+}
+
+// Returns 32 random bits (xorshift64*, as random_u32)
+static unsigned int island_random(Island* island) {
+    island->rng_state ^= island->rng_state >> 12;
+    island->rng_state ^= island->rng_state << 25;
+    island->rng_state ^= island->rng_state >> 27;
+    return (unsigned int)((island->rng_state * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+// Waits while condition on queue holds: yields WAIT_SPINS times, then blocks until wake_queue or
+// abort_run; returns 0 if the run was aborted meanwhile. Waiter and waker both update sleepers
+// (read-modify-writes are totally ordered), so either the waiter sees the change or it is woken.
+#define WAIT_WHILE(archipelago, queue, condition)                                    \
+    for (int spins = 0; condition; ++spins) {                                        \
+        if (atomic_load_explicit(&(archipelago)->aborted, memory_order_relaxed)) {   \
+            return 0;                                                                \
+        }                                                                            \
+        if (spins < WAIT_SPINS) {                                                    \
+            sched_yield();                                                           \
+            continue;                                                                \
+        }                                                                            \
+        pthread_mutex_lock(&(queue)->mutex);                                         \
+        atomic_fetch_add(&(queue)->sleepers, 1);                                     \
+        while ((condition) && !atomic_load(&(archipelago)->aborted)) {               \
+            pthread_cond_wait(&(queue)->wake, &(queue)->mutex);                      \
+        }                                                                            \
+        atomic_fetch_sub(&(queue)->sleepers, 1);                                     \
+        pthread_mutex_unlock(&(queue)->mutex);                                       \
+    }
+
+// Wakes the islands blocked on queue after its head or tail moved
+static void wake_queue(MigrantQueue* queue) {
+    if (atomic_fetch_add(&queue->sleepers, 0) > 0) {
+        pthread_mutex_lock(&queue->mutex);
+        pthread_cond_broadcast(&queue->wake);
+        pthread_mutex_unlock(&queue->mutex);
+    }
+}
+
+// Stops every island at its next check and wakes those that are blocked
+static void abort_run(Archipelago* archipelago) {
+    atomic_store(&archipelago->aborted, 1);
+    for (int i = 0; i < archipelago->config.islands; ++i) {
+        MigrantQueue* queue = &archipelago->islands[i].inbox;
+        pthread_mutex_lock(&queue->mutex);
+        pthread_cond_broadcast(&queue->wake);
+        pthread_mutex_unlock(&queue->mutex);
+    }
+}
+
+// Moves randomly chosen life forms of island into the inbox of the next island; returns 0 if aborted
+static int emigrate(Archipelago* archipelago, Island* island) {
+    MigrantQueue* queue = &archipelago->islands[(island->index + 1) % archipelago->config.islands].inbox;
+    long long head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    WAIT_WHILE(archipelago, queue,
+               head - atomic_load_explicit(&queue->tail, memory_order_acquire) == MIGRATION_QUEUE_DEPTH);
+    int slot = (int)(head % MIGRATION_QUEUE_DEPTH);
+    LifeForm* batch = queue->slots + (size_t)slot * archipelago->config.migrants;
+    World* world = island->world;
+    int count = 0;
+    while (count < archipelago->config.migrants && world->life_form_count > 0) {
+        int chosen = (int)(island_random(island) % (unsigned int)world->life_form_count);
+        batch[count] = world->life_forms[chosen];
+        batch[count++].energy = life_form_energy_at(world, &world->life_forms[chosen], energy_clock(world));
+        world->life_forms[chosen] = world->life_forms[--world->life_form_count];
+    }
+    queue->counts[slot] = count;
+    world->state_version++;
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+    wake_queue(queue);
+    return 1;
+}
+
+// Adds the next batch of island's inbox to its world, as far as there is room; returns 0 if aborted
+static int immigrate(Archipelago* archipelago, Island* island) {
+    MigrantQueue* queue = &island->inbox;
+    long long tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    WAIT_WHILE(archipelago, queue, atomic_load_explicit(&queue->head, memory_order_acquire) == tail);
+    int slot = (int)(tail % MIGRATION_QUEUE_DEPTH);
+    const LifeForm* batch = queue->slots + (size_t)slot * archipelago->config.migrants;
+    World* world = island->world;
+    world->state_version++;
+    for (int i = 0; i < queue->counts[slot] && world->life_form_count < world->max_life_forms; ++i) {
+        LifeForm* lf = &world->life_forms[world->life_form_count++];
+        *lf = batch[i];
+        set_life_form_energy(world, lf, batch[i].energy); // Decaying from now, at this island's loss
+        island->arrivals++;
+    }
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+    wake_queue(queue);
+    return 1;
+}
+
+// Island thread: steps its world to the next migration, migrates, and so on
+static void* island_main(void* arg) {
+    Island* island = (Island*)arg;
+    Archipelago* archipelago = island->archipelago;
+    pin_thread(archipelago->pin, island->index, archipelago->config.islands);
+    World* world = island->world;
+    long long interval = archipelago->config.migration_interval;
+    long long start = world->step;
+    long long end = start + island->steps;
+    while (world->step < end && !atomic_load_explicit(&archipelago->aborted, memory_order_relaxed)) {
+        long long next = (world->step / interval + 1) * interval;
+        if (next > end) next = end;
+        if (world_step_n(world, next - world->step) < next - world->step) {
+            break; // Validation mismatch, already reported
+        }
+        if (world->step % interval == 0 && !(emigrate(archipelago, island) && immigrate(archipelago, island))) {
+            break;
+        }
+    }
+    island->completed = world->step - start;
+    if (world->step < end) {
+        abort_run(archipelago);
+    }
+    return NULL;
+}
+
+// --- Archipelago API ---
+
+// Creates the islands; returns NULL (after printing why) on failure
+Archipelago* archipelago_create(const WorldConfig* config, const IslandConfig* islands) {
+    if (islands->islands < 1 || islands->migration_interval < 1 || islands->migrants < 0
+        || islands->migrants > config->max_life_forms) {
+        fprintf(stderr, "Islands need at least 1 island, a migration interval of at least 1 step and 0 to %d migrants\n",
+                config->max_life_forms);
+        return NULL;
+    }
+    Archipelago* archipelago = (Archipelago*)sim_malloc(sizeof(Archipelago));
+    if (archipelago == NULL) {
+        fprintf(stderr, "Memory allocation failed for the islands!\n");
+        return NULL;
+    }
+    memset(archipelago, 0, sizeof(*archipelago));
+    archipelago->config = *islands;
+    archipelago->pin = config->pin;
+    atomic_init(&archipelago->aborted, 0);
+    // Island threads are pinned instead of the worlds' pools; with one thread per world, pinning
+    // the pool would pin the thread creating the worlds
+    WorldConfig island_config = *config;
+    island_config.pin = PIN_NONE;
+    archipelago->islands = (Island*)sim_malloc(islands->islands * sizeof(Island));
+    int ok = archipelago->islands != NULL;
+    if (ok) {
+        memset(archipelago->islands, 0, islands->islands * sizeof(Island));
+        for (int i = 0; i < islands->islands; ++i) {
+            atomic_init(&archipelago->islands[i].inbox.sleepers, 0);
+            pthread_mutex_init(&archipelago->islands[i].inbox.mutex, NULL);
+            pthread_cond_init(&archipelago->islands[i].inbox.wake, NULL);
+        }
+    }
+    for (int i = 0; ok && i < islands->islands; ++i) {
+        Island* island = &archipelago->islands[i];
+        island->archipelago = archipelago;
+        island->index = i;
+        island_config.seed = config->seed + i;
+        island->world = world_create(&island_config);
+        island->rng_state = island->world != NULL ? island->world->rng_state ^ 0xD1B54A32D192ED03ULL : 0;
+        island->rng_state = island->rng_state != 0 ? island->rng_state : 0x9E3779B97F4A7C15ULL;
+        atomic_init(&island->inbox.head, 0);
+        atomic_init(&island->inbox.tail, 0);
+        // Batches are indexed with a stride of migrants; one life form still allocates with none
+        int batch_size = islands->migrants > 0 ? islands->migrants : 1;
+        island->inbox.slots = (LifeForm*)sim_malloc((size_t)MIGRATION_QUEUE_DEPTH * batch_size * sizeof(LifeForm));
+        ok = island->world != NULL && island->inbox.slots != NULL;
+    }
+    if (!ok) {
+        fprintf(stderr, "Could not create the islands\n");
+        archipelago_destroy(archipelago);
+        return NULL;
+    }
+    return archipelago;
+}
+
+// Destroys the islands and their worlds
+void archipelago_destroy(Archipelago* archipelago) {
+    if (archipelago == NULL) {
+        return;
+    }
+    for (int i = 0; archipelago->islands != NULL && i < archipelago->config.islands; ++i) {
+        world_destroy(archipelago->islands[i].world);
+        sim_free(archipelago->islands[i].inbox.slots);
+        pthread_cond_destroy(&archipelago->islands[i].inbox.wake);
+        pthread_mutex_destroy(&archipelago->islands[i].inbox.mutex);
+    }
+    sim_free(archipelago->islands);
+    sim_free(archipelago);
+}
+
+// Steps every island steps steps, each on its own thread; the caller only waits, so pinning the
+// island threads leaves its own affinity alone. Migrations happen whenever the step count reaches
+// a multiple of the migration interval. Once a run stops early (a validation mismatch), the
+// islands stay stopped.
+long long archipelago_run(Archipelago* archipelago, long long steps) {
+    int count = archipelago->config.islands;
+    for (int i = 0; i < count; ++i) {
+        archipelago->islands[i].steps = steps;
+        archipelago->islands[i].completed = 0;
+    }
+    int started = 0;
+    for (; started < count; ++started) {
+        if (pthread_create(&archipelago->islands[started].thread, NULL, island_main, &archipelago->islands[started]) != 0) {
+            fprintf(stderr, "Could not start island thread %d!\n", started);
+            abort_run(archipelago);
+            break;
+        }
+    }
+    for (int i = 0; i < started; ++i) {
+        pthread_join(archipelago->islands[i].thread, NULL);
+    }
+    long long completed = steps;
+    for (int i = 0; i < count; ++i) {
+        if (archipelago->islands[i].completed < completed) {
+            completed = archipelago->islands[i].completed;
+        }
+    }
+    return completed;
+}
+
+int archipelago_island_count(const Archipelago* archipelago) {
+    return archipelago->config.islands;
+}
+
+World* archipelago_island(Archipelago* archipelago, int island) {
+    return archipelago->islands[island].world;
+}
+
+long long archipelago_migrant_count(const Archipelago* archipelago) {
+    long long total = 0;
+    for (int i = 0; i < archipelago->config.islands; ++i) {
+        total += archipelago->islands[i].arrivals;
+    }
+    return total;
+}
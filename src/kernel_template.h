@@ -0,0 +1,396 @@
+// Kernel template: the update and interaction kernels, written once against parameter macros and
+// instantiated by including this file after defining them. No include guard: every inclusion
+// instantiates the kernels again under a new name.
+//
+//   K_NAME(name)               Name of an instantiated function, e.g. name##_generic
+//   K_WIDTH(world)             World size
+//   K_HEIGHT(world)
+//   K_LIFE_FORM_RADIUS(world)
+//   K_FOOD_RADIUS(world)
+//   K_SENSE_RADIUS(world)
+//   K_BOUNDARY(world)          BoundaryPolicy
+//   K_SENSING(world)           SensingMode
+//
+// The generic instantiation (kernels.c) reads the parameters from world->params. Specialized
+// instantiations (generated from src/kernel_spec.c.in) define them as constants, so the compiler
+// folds the constants into the loops and drops the branches of the other policies and modes.
+// Both must compute bit-identical results; validation compares them (world_set_validation). The
+// event-driven kernels must compute the same as the stepped ones. The food field kernels
+// replace both in FOOD_FIELD worlds; the scent kernel at the end runs after either in worlds with scent.
+// The ecology (world->ecology) is read at run time by every instantiation. Energy is not updated
+// here: it decays in closed form (life_form_energy_at) and is only stored when a life form feeds.
+
+// Offset from a to b along an axis of the given size; on a torus the shorter way round
+static inline double K_NAME(axis_delta)(const World* world, double a, double b, double size) {
+    double d = b - a;
+    if (K_BOUNDARY(world) == BOUNDARY_WRAP) {
+        if (d > size * 0.5) {
+            d -= size;
+        } else if (d < -size * 0.5) {
+            d += size;
+        }
+    }
+    (void)world;
+    return d;
+}
+
+// Moves lf by its velocity and handles the boundaries: bounce off the walls, or wrap around
+static inline void K_NAME(move_life_form)(const World* world, LifeForm* lf) {
+    lf->x += lf->vx;
+    lf->y += lf->vy;
+
+    if (K_BOUNDARY(world) == BOUNDARY_BOUNCE) {
+        if (lf->x - K_LIFE_FORM_RADIUS(world) < 0) {
+            lf->x = K_LIFE_FORM_RADIUS(world);
+            lf->vx *= -1;
+        } else if (lf->x + K_LIFE_FORM_RADIUS(world) > K_WIDTH(world)) {
+            lf->x = K_WIDTH(world) - K_LIFE_FORM_RADIUS(world);
+            lf->vx *= -1;
+        }
+
+        if (lf->y - K_LIFE_FORM_RADIUS(world) < 0) {
+            lf->y = K_LIFE_FORM_RADIUS(world);
+            lf->vy *= -1;
+        } else if (lf->y + K_LIFE_FORM_RADIUS(world) > K_HEIGHT(world)) {
+            lf->y = K_HEIGHT(world) - K_LIFE_FORM_RADIUS(world);
+            lf->vy *= -1;
+        }
+    } else {
+        if (lf->x < 0) {
+            lf->x += K_WIDTH(world);
+        } else if (lf->x >= K_WIDTH(world)) {
+            lf->x -= K_WIDTH(world);
+        }
+
+        if (lf->y < 0) {
+            lf->y += K_HEIGHT(world);
+        } else if (lf->y >= K_HEIGHT(world)) {
+            lf->y -= K_HEIGHT(world);
+        }
+    }
+    (void)world;
+}
+
+// Steers lf towards the food at offset (dx, dy), or wanders if target is -1
+static inline void K_NAME(steer_life_form)(World* world, LifeForm* lf, int target, double dx, double dy) {
+    if (target != -1) {
+        // Adjust velocity towards nearest food
+        double angle = atan2(dy, dx);
+        lf->vx = cos(angle) * MAX_SPEED * lf->speed_factor;
+        lf->vy = sin(angle) * MAX_SPEED * lf->speed_factor;
+    } else {
+        // If no food, randomly change direction occasionally
+        if (random_unit(world) < 0.01) { // 1% chance to change direction
+            lf->vx = (random_unit(world) - 0.5) * MAX_SPEED * lf->speed_factor;
+            lf->vy = (random_unit(world) - 0.5) * MAX_SPEED * lf->speed_factor;
+        }
+    }
+    (void)world;
+}
+
+// Updates the state of a single life form
+void K_NAME(update_life_form)(World* world, LifeForm* lf, const Food* foods, int num_foods) {
+    // 1. Movement and boundaries
+    K_NAME(move_life_form)(world, lf);
+
+    // 2. Simple seeking behavior (towards nearest food, within sensing range)
+    double nearest_food_dist_sq = -1.0;
+    int nearest_food_idx = -1;
+    double nearest_dx = 0.0;
+    double nearest_dy = 0.0;
+
+    for (int i = 0; i < num_foods; ++i) {
+        if (foods[i].is_present) {
+            double dx = K_NAME(axis_delta)(world, lf->x, foods[i].x, K_WIDTH(world));
+            double dy = K_NAME(axis_delta)(world, lf->y, foods[i].y, K_HEIGHT(world));
+            double dist_sq = dx * dx + dy * dy;
+            if (K_SENSING(world) == SENSE_LOCAL && dist_sq > K_SENSE_RADIUS(world) * K_SENSE_RADIUS(world)) {
+                continue;
+            }
+            if (nearest_food_idx == -1 || dist_sq < nearest_food_dist_sq) {
+                nearest_food_dist_sq = dist_sq;
+                nearest_food_idx = i;
+                nearest_dx = dx;
+                nearest_dy = dy;
+            }
+        }
+    }
+
+    // 3. Steering
+    K_NAME(steer_life_form)(world, lf, nearest_food_idx, nearest_dx, nearest_dy);
+}
+
+// Updates life forms [begin, end)
+void K_NAME(update_life_form_range)(World* world, int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        K_NAME(update_life_form)(world, &world->life_forms[i], world->food_sources, world->food_count);
+    }
+}
+
+// Handles interactions between life forms and food
+void K_NAME(handle_interactions)(World* world) {
+    double combined_radius = K_LIFE_FORM_RADIUS(world) + K_FOOD_RADIUS(world);
+    double combined_radius_sq = combined_radius * combined_radius;
+    long long clock = energy_clock(world);
+
+    // Check for feeding
+    for (int i = 0; i < world->life_form_count; ++i) {
+        LifeForm* lf = &world->life_forms[i];
+        for (int j = 0; j < world->food_count; ++j) {
+            Food* food = &world->food_sources[j];
+            if (food->is_present) {
+                double dx = K_NAME(axis_delta)(world, lf->x, food->x, K_WIDTH(world));
+                double dy = K_NAME(axis_delta)(world, lf->y, food->y, K_HEIGHT(world));
+                if (dx * dx + dy * dy < combined_radius_sq) {
+                    set_life_form_energy(world, lf, life_form_energy_at(world, lf, clock) + world->ecology.energy_gain);
+                    food->is_present = 0; // Food consumed
+                    RECORD_FEED(world, lf, food);
+                    // Try to respawn new food
+                    if (random_unit(world) < world->ecology.food_respawn_chance) { // Chance to respawn food
+                         spawn_food(
+                            world,
+                            random_unit(world) * K_WIDTH(world),
+                            random_unit(world) * K_HEIGHT(world)
+                        );
+                    }
+                }
+            }
+        }
+    }
+
+    // Clean up consumed food and compact the array (simple removal)
+    int current_food_idx = 0;
+    for (int i = 0; i < world->food_count; ++i) {
+        if (world->food_sources[i].is_present) {
+            world->food_sources[current_food_idx++] = world->food_sources[i];
+        }
+    }
+    world->food_count = current_food_idx;
+}
+
+// --- Event-Driven Kernels ---
+// update_life_form_range and handle_interactions for the event-driven engine: the same steps with
+// the same arithmetic, skipping the food searches and contact checks whose outcome the life form's
+// FoodSchedule already knows (events.c)
+
+// Updates life forms [begin, end), searching for food only where the outcome may have changed
+void K_NAME(update_life_form_range_events)(World* world, int begin, int end) {
+    const Food* foods = world->food_sources;
+    long long step = world->step;
+    for (int i = begin; i < end; ++i) {
+        LifeForm* lf = &world->life_forms[i];
+        FoodSchedule* schedule = &world->schedules[i];
+        K_NAME(move_life_form)(world, lf);
+
+        int target = schedule->target;
+        double dx = 0.0;
+        double dy = 0.0;
+        if (step < schedule->search_until) {
+            if (target != -1) {
+                dx = K_NAME(axis_delta)(world, lf->x, foods[target].x, K_WIDTH(world));
+                dy = K_NAME(axis_delta)(world, lf->y, foods[target].y, K_HEIGHT(world));
+            }
+        } else {
+            // The search of update_life_form, also keeping the two smallest distances to any food
+            double target_dist_sq = -1.0;
+            double nearest_sq = INFINITY;
+            double second_sq = INFINITY;
+            target = -1;
+            for (int j = 0; j < world->food_count; ++j) {
+                if (foods[j].is_present) {
+                    double fdx = K_NAME(axis_delta)(world, lf->x, foods[j].x, K_WIDTH(world));
+                    double fdy = K_NAME(axis_delta)(world, lf->y, foods[j].y, K_HEIGHT(world));
+                    double dist_sq = fdx * fdx + fdy * fdy;
+                    if (dist_sq < nearest_sq) {
+                        second_sq = nearest_sq;
+                        nearest_sq = dist_sq;
+                    } else if (dist_sq < second_sq) {
+                        second_sq = dist_sq;
+                    }
+                    if (K_SENSING(world) == SENSE_LOCAL && dist_sq > K_SENSE_RADIUS(world) * K_SENSE_RADIUS(world)) {
+                        continue;
+                    }
+                    if (target == -1 || dist_sq < target_dist_sq) {
+                        target_dist_sq = dist_sq;
+                        target = j;
+                        dx = fdx;
+                        dy = fdy;
+                    }
+                }
+            }
+            schedule_food_search(world, lf, schedule, target, nearest_sq, second_sq);
+        }
+        K_NAME(steer_life_form)(world, lf, target, dx, dy);
+    }
+}
+
+// Feeding and food respawn, checking only the life forms that may be touching food
+void K_NAME(handle_interactions_events)(World* world) {
+    double combined_radius = K_LIFE_FORM_RADIUS(world) + K_FOOD_RADIUS(world);
+    double combined_radius_sq = combined_radius * combined_radius;
+    long long clock = energy_clock(world);
+    int eaten = 0;
+
+    for (int i = 0; i < world->life_form_count; ++i) {
+        FoodSchedule* schedule = &world->schedules[i];
+        if (world->step < schedule->contact_from) {
+            continue;
+        }
+        LifeForm* lf = &world->life_forms[i];
+        double nearest_sq = INFINITY;
+        int fed = 0;
+        for (int j = 0; j < world->food_count; ++j) {
+            Food* food = &world->food_sources[j];
+            if (food->is_present) {
+                double dx = K_NAME(axis_delta)(world, lf->x, food->x, K_WIDTH(world));
+                double dy = K_NAME(axis_delta)(world, lf->y, food->y, K_HEIGHT(world));
+                double dist_sq = dx * dx + dy * dy;
+                if (dist_sq < combined_radius_sq) {
+                    set_life_form_energy(world, lf, life_form_energy_at(world, lf, clock) + world->ecology.energy_gain);
+                    food->is_present = 0; // Food consumed
+                    RECORD_FEED(world, lf, food);
+                    fed = 1;
+                    // Try to respawn new food
+                    if (random_unit(world) < world->ecology.food_respawn_chance) { // Chance to respawn food
+                        int food_before = world->food_count;
+                        spawn_food(
+                            world,
+                            random_unit(world) * K_WIDTH(world),
+                            random_unit(world) * K_HEIGHT(world)
+                        );
+                        if (world->food_count > food_before) {
+                            schedule_new_food(world, food_before);
+                        }
+                    }
+                } else if (dist_sq < nearest_sq) {
+                    nearest_sq = dist_sq;
+                }
+            }
+        }
+        // Having just eaten, the life form may be touching more food next step
+        schedule_contact(world, schedule, fed ? 0.0 : nearest_sq);
+        eaten += fed;
+    }
+    if (eaten > 0) {
+        world->reproduce_due = 1;
+    }
+
+    // Clean up consumed food and compact the array, recording where every food source went
+    int current_food_idx = 0;
+    for (int i = 0; i < world->food_count; ++i) {
+        if (world->food_sources[i].is_present) {
+            world->food_remap[i] = current_food_idx;
+            world->food_sources[current_food_idx++] = world->food_sources[i];
+        } else {
+            world->food_remap[i] = -1;
+        }
+    }
+    if (current_food_idx < world->food_count) {
+        world->food_count = current_food_idx;
+        schedule_food_compaction(world);
+    }
+}
+
+
+// --- Food Field Kernels ---
+// update_life_form_range and handle_interactions for FOOD_FIELD worlds (see world_field): life forms
+// steer up the density gradient and graze the cell they are in. Neither searches anything, so both
+// cost the same per life form however much food there is.
+
+// Index of the cell containing (x, y) in a columns x rows grid spanning the world; cells stretch with it
+static inline int K_NAME(grid_cell)(const World* world, int columns, int rows, double x, double y) {
+    int column = (int)(x * columns / K_WIDTH(world));
+    int row = (int)(y * rows / K_HEIGHT(world));
+    column = column < 0 ? 0 : column >= columns ? columns - 1 : column;
+    row = row < 0 ? 0 : row >= rows ? rows - 1 : row;
+    (void)world;
+    return row * columns + column;
+}
+
+// Central-difference gradient of a columns x rows grid at cell, per unit length
+static inline void K_NAME(grid_gradient)(const World* world, const float* cells, int columns, int rows, int cell,
+                                         double* gx, double* gy) {
+    int column = cell % columns;
+    int row = cell / columns;
+    // Neighbours across the edges on a torus; at a bouncing wall the cell itself (no gradient across it)
+    int left = column > 0 ? cell - 1 : K_BOUNDARY(world) == BOUNDARY_WRAP ? cell + columns - 1 : cell;
+    int right = column < columns - 1 ? cell + 1 : K_BOUNDARY(world) == BOUNDARY_WRAP ? cell - column : cell;
+    int up = row > 0 ? cell - columns : K_BOUNDARY(world) == BOUNDARY_WRAP ? cell + (rows - 1) * columns : cell;
+    int down = row < rows - 1 ? cell + columns : K_BOUNDARY(world) == BOUNDARY_WRAP ? column : cell;
+    *gx = ((double)cells[right] - cells[left]) / (K_WIDTH(world) / columns);
+    *gy = ((double)cells[down] - cells[up]) / (K_HEIGHT(world) / rows);
+    (void)world;
+}
+
+// Updates life forms [begin, end): moves each and turns it up the field's central-difference
+// gradient at its cell; where the field is flat it keeps its heading. Draws no random numbers.
+void K_NAME(update_life_form_range_field)(World* world, int begin, int end) {
+    const FoodField* field = &world->field;
+    for (int i = begin; i < end; ++i) {
+        LifeForm* lf = &world->life_forms[i];
+        K_NAME(move_life_form)(world, lf);
+
+        int cell = K_NAME(grid_cell)(world, field->columns, field->rows, lf->x, lf->y);
+        double gx, gy;
+        K_NAME(grid_gradient)(world, field->cells, field->columns, field->rows, cell, &gx, &gy);
+        if (gx != 0.0 || gy != 0.0) {
+            double angle = atan2(gy, gx);
+            lf->vx = cos(angle) * MAX_SPEED * lf->speed_factor;
+            lf->vy = sin(angle) * MAX_SPEED * lf->speed_factor;
+        }
+    }
+}
+
+// Every life form, in order, eats up to field_graze from its cell; the field's regrowth and
+// diffusion follow in the same phase (step_food_field)
+void K_NAME(graze_field)(World* world) {
+    const FoodField* field = &world->field;
+    float graze = (float)world->ecology.field_graze;
+    long long clock = energy_clock(world);
+    for (int i = 0; i < world->life_form_count; ++i) {
+        LifeForm* lf = &world->life_forms[i];
+        float* cell = &field->cells[K_NAME(grid_cell)(world, field->columns, field->rows, lf->x, lf->y)];
+        float eaten = *cell < graze ? *cell : graze;
+        if (eaten > 0) {
+            *cell -= eaten;
+            set_life_form_energy(world, lf, life_form_energy_at(world, lf, clock) + eaten * world->ecology.energy_gain);
+        }
+    }
+}
+
+// --- Scent Kernels ---
+
+// Follows the update kernel in worlds with scent fields (see world_scent): turns life forms
+// [begin, end) by the sum of every scent gradient at their cell times its attraction, slowing them
+// to their top speed if that makes them faster, and records the cell each leaves its scent in
+// (ScentFields.deposit_cells). Draws no random numbers and writes nothing shared.
+void K_NAME(follow_scent_range)(World* world, int begin, int end) {
+    const ScentFields* scent = &world->scent;
+    size_t stride = grid_cells(scent->columns, scent->rows);
+    for (int i = begin; i < end; ++i) {
+        LifeForm* lf = &world->life_forms[i];
+        int cell = K_NAME(grid_cell)(world, scent->columns, scent->rows, lf->x, lf->y);
+        for (int index = 0; index < scent->count; ++index) {
+            double gx, gy;
+            K_NAME(grid_gradient)(world, scent->cells + index * stride, scent->columns, scent->rows, cell, &gx, &gy);
+            lf->vx += world->ecology.scent[index].attraction * gx;
+            lf->vy += world->ecology.scent[index].attraction * gy;
+        }
+        double speed = sqrt(lf->vx * lf->vx + lf->vy * lf->vy);
+        double max_speed = MAX_SPEED * lf->speed_factor;
+        if (speed > max_speed) {
+            lf->vx *= max_speed / speed;
+            lf->vy *= max_speed / speed;
+        }
+        scent->deposit_cells[i] = cell;
+    }
+}
+
+#undef K_NAME
+#undef K_WIDTH
+#undef K_HEIGHT
+#undef K_LIFE_FORM_RADIUS
+#undef K_FOOD_RADIUS
+#undef K_SENSE_RADIUS
+#undef K_BOUNDARY
+#undef K_SENSING
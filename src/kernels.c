@@ -0,0 +1,230 @@
+#include <stdio.h>    // For error messages (fprintf)
+#include <string.h>   // For strcmp
+#include <math.h>     // For mathematical functions (sqrt, atan2, cos, sin) and isfinite
+
+#include "alife_internal.h"
+
+static const char* boundary_policy_names[BOUNDARY_POLICY_COUNT] = { "bounce", "wrap" };
+static const char* sensing_mode_names[SENSING_MODE_COUNT] = { "global", "local" };
+static const char* engine_names[ENGINE_COUNT] = { "stepped", "event" };
+static const char* food_model_names[FOOD_MODEL_COUNT] = { "points", "field" };
+
+// --- Generic Kernels ---
+// Read every parameter from world->params at run time; used for any parameter set the build has
+// no specialization for, and as the reference kernels that validation checks specializations against
+
+#define K_NAME(name) name##_generic
+#define K_WIDTH(world) ((world)->params.width)
+#define K_HEIGHT(world) ((world)->params.height)
+#define K_LIFE_FORM_RADIUS(world) ((world)->params.life_form_radius)
+#define K_FOOD_RADIUS(world) ((world)->params.food_radius)
+#define K_SENSE_RADIUS(world) ((world)->params.sense_radius)
+#define K_BOUNDARY(world) ((world)->params.boundary)
+#define K_SENSING(world) ((world)->params.sensing)
+#include "kernel_template.h"
+
+const KernelSet generic_kernels = { "generic", { 0.0, 0.0, 0.0, 0.0, 0.0, BOUNDARY_BOUNCE, SENSE_GLOBAL },
+                                    update_life_form_range_generic, handle_interactions_generic,
+                                    update_life_form_range_events_generic, handle_interactions_events_generic,
+                                    update_life_form_range_field_generic, graze_field_generic,
+                                    follow_scent_range_generic };
+
+// --- Specialized Kernels ---
+// kernel_specializations.h is generated by CMake from ALIFE_SPECIALIZE, one line per entry:
+//   ALIFE_SPECIALIZATION(suffix, "spec", width, height, life form radius, food radius, sense radius,
+//                        boundary, sensing)
+// and each entry's kernels are instantiated in their own generated source file.
+
+#define ALIFE_SPECIALIZATION(suffix, spec, width, height, life_form_radius, food_radius, sense_radius, \
+                             boundary, sensing)                                                      \
+    void update_life_form_range_##suffix(World* world, int begin, int end);                           \
+    void handle_interactions_##suffix(World* world);                                                  \
+    void update_life_form_range_events_##suffix(World* world, int begin, int end);                    \
+    void handle_interactions_events_##suffix(World* world);                                           \
+    void update_life_form_range_field_##suffix(World* world, int begin, int end);                     \
+    void graze_field_##suffix(World* world);                                                          \
+    void follow_scent_range_##suffix(World* world, int begin, int end);
+#include "kernel_specializations.h"
+#undef ALIFE_SPECIALIZATION
+
+static const KernelSet specialized_kernels[] = {
+#define ALIFE_SPECIALIZATION(suffix, spec, width, height, life_form_radius, food_radius, sense_radius, \
+                             boundary, sensing)                                                      \
+    { spec, { width, height, life_form_radius, food_radius, sense_radius, boundary, sensing },        \
+      update_life_form_range_##suffix, handle_interactions_##suffix,                                  \
+      update_life_form_range_events_##suffix, handle_interactions_events_##suffix,                    \
+      update_life_form_range_field_##suffix, graze_field_##suffix, follow_scent_range_##suffix },
+#include "kernel_specializations.h"
+#undef ALIFE_SPECIALIZATION
+    { NULL, { 0.0, 0.0, 0.0, 0.0, 0.0, BOUNDARY_BOUNCE, SENSE_GLOBAL }, NULL, NULL, NULL, NULL, NULL, NULL, NULL } // End of the table
+};
+
+// --- Kernel Selection ---
+
+// Returns 1 if a specialization built for built_for computes the same as the generic kernels with params
+int params_match(const WorldParams* built_for, const WorldParams* params) {
+    return built_for->width == params->width && built_for->height == params->height
+           && built_for->life_form_radius == params->life_form_radius
+           && built_for->food_radius == params->food_radius
+           && built_for->boundary == params->boundary && built_for->sensing == params->sensing
+           && (params->sensing != SENSE_LOCAL || built_for->sense_radius == params->sense_radius);
+}
+
+// Returns the kernels for params: a matching specialization if allowed and built in, else the generic ones
+const KernelSet* select_kernels(const WorldParams* params, int specialized) {
+    for (int i = 0; specialized && specialized_kernels[i].name != NULL; ++i) {
+        if (params_match(&specialized_kernels[i].params, params)) {
+            return &specialized_kernels[i];
+        }
+    }
+    return &generic_kernels;
+}
+
+// --- World Parameters ---
+
+// Fills params with the default world
+void default_world_params(WorldParams* params) {
+    params->width = WORLD_WIDTH;
+    params->height = WORLD_HEIGHT;
+    params->life_form_radius = LIFE_FORM_RADIUS;
+    params->food_radius = FOOD_RADIUS;
+    params->sense_radius = SENSE_RADIUS;
+    params->boundary = BOUNDARY_BOUNCE;
+    params->sensing = SENSE_GLOBAL;
+}
+
+// Fills ecology with the default energy budget and rates
+void default_ecology_params(EcologyParams* ecology) {
+    ecology->reproduction_threshold = REPRODUCTION_THRESHOLD;
+    ecology->energy_loss = ENERGY_LOSS_PER_STEP;
+    ecology->energy_gain = ENERGY_GAIN_FROM_FOOD;
+    ecology->mutation_width = MUTATION_WIDTH;
+    ecology->min_speed_factor = MIN_SPEED_FACTOR;
+    ecology->max_speed_factor = MAX_SPEED_FACTOR;
+    ecology->food_respawn_chance = FOOD_RESPAWN_CHANCE;
+    ecology->field_regrowth = FIELD_REGROWTH;
+    ecology->field_diffusion = FIELD_DIFFUSION;
+    ecology->field_graze = FIELD_GRAZE;
+    for (int i = 0; i < MAX_SCENT_FIELDS; ++i) {
+        ecology->scent[i].deposit = SCENT_DEPOSIT;
+        ecology->scent[i].decay = SCENT_DECAY;
+        ecology->scent[i].diffusion = SCENT_DIFFUSION;
+        ecology->scent[i].attraction = SCENT_ATTRACTION;
+    }
+}
+
+// Returns 0 (after printing why) if params do not describe a usable world
+int check_world_params(const WorldParams* params) {
+    if (!(params->width > 0 && params->height > 0)) {
+        fprintf(stderr, "World width and height must be positive\n");
+        return 0;
+    }
+    if (!(params->life_form_radius >= 0 && params->food_radius >= 0 && params->sense_radius >= 0)) {
+        fprintf(stderr, "Radii must not be negative\n");
+        return 0;
+    }
+    if (params->boundary == BOUNDARY_BOUNCE
+        && (2 * params->life_form_radius >= params->width || 2 * params->life_form_radius >= params->height)) {
+        fprintf(stderr, "Life forms must be smaller than a bounded world\n");
+        return 0;
+    }
+    if (params->boundary < BOUNDARY_BOUNCE || params->boundary >= BOUNDARY_POLICY_COUNT
+        || params->sensing < SENSE_GLOBAL || params->sensing >= SENSING_MODE_COUNT) {
+        fprintf(stderr, "Unknown boundary policy or sensing mode\n");
+        return 0;
+    }
+    return 1;
+}
+
+// Returns 0 (after printing why) if the ecology's values are out of range
+int check_ecology_params(const EcologyParams* ecology) {
+    if (!(ecology->reproduction_threshold > 0 && ecology->energy_loss >= 0 && ecology->energy_gain >= 0)) {
+        fprintf(stderr, "The reproduction threshold must be positive, energy loss and gain not negative\n");
+        return 0;
+    }
+    if (!(ecology->mutation_width >= 0 && ecology->food_respawn_chance >= 0 && ecology->food_respawn_chance <= 1)) {
+        fprintf(stderr, "The mutation width must not be negative and the food respawn chance in 0..1\n");
+        return 0;
+    }
+    if (!(ecology->min_speed_factor > 0 && ecology->min_speed_factor <= ecology->max_speed_factor
+          && isfinite(ecology->max_speed_factor))) {
+        fprintf(stderr, "The speed factor range must be positive and finite, with min <= max\n");
+        return 0;
+    }
+    // Diffusing more than a quarter to each of four neighbours would overshoot and oscillate
+    if (!(ecology->field_regrowth >= 0 && ecology->field_regrowth <= 1 && ecology->field_diffusion >= 0
+          && ecology->field_diffusion <= 0.25 && ecology->field_graze >= 0)) {
+        fprintf(stderr, "Field regrowth must be in 0..1, diffusion in 0..0.25 and grazing not negative\n");
+        return 0;
+    }
+    for (int i = 0; i < MAX_SCENT_FIELDS; ++i) {
+        const ScentParams* scent = &ecology->scent[i];
+        if (!(scent->deposit >= 0 && scent->decay >= 0 && scent->decay <= 1 && scent->diffusion >= 0
+              && scent->diffusion <= 0.25 && isfinite(scent->attraction))) {
+            fprintf(stderr, "Scent deposit must not be negative, decay must be in 0..1, diffusion in 0..0.25 "
+                    "and attraction finite\n");
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Returns the name of a boundary policy
+const char* boundary_policy_name(BoundaryPolicy policy) {
+    return policy >= BOUNDARY_BOUNCE && policy < BOUNDARY_POLICY_COUNT ? boundary_policy_names[policy] : "?";
+}
+
+// Returns the BoundaryPolicy with the given name, or -1
+int parse_boundary_policy(const char* name) {
+    for (int i = 0; i < BOUNDARY_POLICY_COUNT; ++i) {
+        if (strcmp(boundary_policy_names[i], name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Returns the name of a sensing mode
+const char* sensing_mode_name(SensingMode mode) {
+    return mode >= SENSE_GLOBAL && mode < SENSING_MODE_COUNT ? sensing_mode_names[mode] : "?";
+}
+
+// Returns the SensingMode with the given name, or -1
+int parse_sensing_mode(const char* name) {
+    for (int i = 0; i < SENSING_MODE_COUNT; ++i) {
+        if (strcmp(sensing_mode_names[i], name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Returns the name of an engine
+const char* engine_name(EngineKind engine) {
+    return engine >= ENGINE_STEPPED && engine < ENGINE_COUNT ? engine_names[engine] : "?";
+}
+
+// Returns the EngineKind with the given name, or -1
+int parse_engine(const char* name) {
+    for (int i = 0; i < ENGINE_COUNT; ++i) {
+        if (strcmp(engine_names[i], name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Returns the name of a food model
+const char* food_model_name(FoodModel model) {
+    return model >= FOOD_POINTS && model < FOOD_MODEL_COUNT ? food_model_names[model] : "?";
+}
+
+// Returns the FoodModel with the given name, or -1
+int parse_food_model(const char* name) {
+    for (int i = 0; i < FOOD_MODEL_COUNT; ++i) {
+        if (strcmp(food_model_names[i], name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,149 @@
+#include <stdio.h>    // For error messages (fprintf)
+#include <stdlib.h>   // For malloc, free (what sim_malloc, sim_free expand to without ALIFE_TRACK_ALLOCS)
+
+#include "alife_internal.h"
+
+// --- Observer Registration ---
+// Events are recorded into buffers preallocated at the world's capacities, so recording never
+// allocates during a step and never has to check for space. Each observer is called once per
+// phase with the whole batch, after the phase is timed, so observers cost the kernels nothing
+// but the recording itself.
+
+#if ALIFE_OBSERVE_BIRTH || ALIFE_OBSERVE_DEATH || ALIFE_OBSERVE_FEED
+// Allocates *buffer for capacity events of the given size unless already allocated; returns 0 on failure
+static int ensure_buffer(void** buffer, int capacity, size_t size, const char* category) {
+    if (*buffer == NULL) {
+        *buffer = sim_malloc((size_t)capacity * size);
+        if (*buffer == NULL) {
+            fprintf(stderr, "Memory allocation failed for the %s event buffer!\n", category);
+            return 0;
+        }
+    }
+    return 1;
+}
+#endif
+
+#if !ALIFE_OBSERVE_BIRTH || !ALIFE_OBSERVE_DEATH || !ALIFE_OBSERVE_FEED || !ALIFE_OBSERVE_STEP
+// Reports an observer category left out of the build by ALIFE_OBSERVERS
+static int not_built_in(const char* category) {
+    fprintf(stderr, "%s observers are not built in (see ALIFE_OBSERVERS)\n", category);
+    return 0;
+}
+#endif
+
+// Registers the birth observer (NULL removes it); returns 0 if births are not observable
+int world_observe_births(World* world, BirthObserver observer, void* user) {
+#if ALIFE_OBSERVE_BIRTH
+    if (observer != NULL && !ensure_buffer((void**)&world->observers.births, world->max_life_forms,
+                                           sizeof(BirthEvent), "birth")) {
+        return 0;
+    }
+    world->observers.birth = observer;
+    world->observers.birth_user = user;
+    return 1;
+#else
+    (void)world, (void)observer, (void)user;
+    return observer == NULL ? 1 : not_built_in("Birth");
+#endif
+}
+
+// Registers the death observer (NULL removes it); returns 0 if deaths are not observable
+int world_observe_deaths(World* world, DeathObserver observer, void* user) {
+#if ALIFE_OBSERVE_DEATH
+    if (observer != NULL && !ensure_buffer((void**)&world->observers.deaths, world->max_life_forms,
+                                           sizeof(DeathEvent), "death")) {
+        return 0;
+    }
+    world->observers.death = observer;
+    world->observers.death_user = user;
+    return 1;
+#else
+    (void)world, (void)observer, (void)user;
+    return observer == NULL ? 1 : not_built_in("Death");
+#endif
+}
+
+// Registers the feeding observer (NULL removes it); returns 0 if feeding is not observable
+int world_observe_feeding(World* world, FeedObserver observer, void* user) {
+#if ALIFE_OBSERVE_FEED
+    if (observer != NULL && !ensure_buffer((void**)&world->observers.feeds, world->max_food_sources,
+                                           sizeof(FeedEvent), "feed")) {
+        return 0;
+    }
+    world->observers.feed = observer;
+    world->observers.feed_user = user;
+    return 1;
+#else
+    (void)world, (void)observer, (void)user;
+    return observer == NULL ? 1 : not_built_in("Feed");
+#endif
+}
+
+// Registers the step observer (NULL removes it); returns 0 if steps are not observable
+int world_observe_steps(World* world, StepObserver observer, void* user) {
+#if ALIFE_OBSERVE_STEP
+    world->observers.step = observer;
+    world->observers.step_user = user;
+    return 1;
+#else
+    (void)world, (void)observer, (void)user;
+    return observer == NULL ? 1 : not_built_in("Step");
+#endif
+}
+
+// Frees the event buffers
+void free_observers(World* world) {
+    sim_free(world->observers.births);
+    sim_free(world->observers.deaths);
+    sim_free(world->observers.feeds);
+}
+
+// --- Notification ---
+
+// Discards the recorded events; called before every kernel run, so a validated phase, which
+// runs twice, reports its events once
+void clear_events(World* world) {
+    world->observers.birth_count = 0;
+    world->observers.death_count = 0;
+    world->observers.feed_count = 0;
+}
+
+// Hands the events recorded by the phase just run to their observers and adds them to the step's totals
+void notify_phase_observers(World* world) {
+    Observers* obs = &world->observers;
+    obs->step_totals.births += obs->birth_count;
+    obs->step_totals.deaths += obs->death_count;
+    obs->step_totals.feeds += obs->feed_count;
+#if ALIFE_OBSERVE_BIRTH
+    if (obs->birth != NULL && obs->birth_count > 0) {
+        obs->birth(obs->birth_user, obs->births, obs->birth_count);
+    }
+#endif
+#if ALIFE_OBSERVE_DEATH
+    if (obs->death != NULL && obs->death_count > 0) {
+        obs->death(obs->death_user, obs->deaths, obs->death_count);
+    }
+#endif
+#if ALIFE_OBSERVE_FEED
+    if (obs->feed != NULL && obs->feed_count > 0) {
+        obs->feed(obs->feed_user, obs->feeds, obs->feed_count);
+    }
+#endif
+}
+
+// Reports the step being finished to the step observer and starts the next step's totals.
+// The totals count only events of observed categories.
+void notify_step_observer(World* world) {
+    Observers* obs = &world->observers;
+#if ALIFE_OBSERVE_STEP
+    if (obs->step != NULL) {
+        obs->step_totals.step = world->step;
+        obs->step_totals.life_forms = world->life_form_count;
+        obs->step_totals.food = world->food_count;
+        obs->step(obs->step_user, &obs->step_totals);
+    }
+#endif
+    obs->step_totals.births = 0;
+    obs->step_totals.deaths = 0;
+    obs->step_totals.feeds = 0;
+}
@@ -0,0 +1,177 @@
+#define _GNU_SOURCE // For pthread_setaffinity_np (thread pinning)
+#include <stdio.h>    // For error messages (fprintf)
+#include <string.h>   // For strcmp
+#include <sched.h>    // For CPU affinity masks (thread pinning)
+#include <unistd.h>   // For sysconf (number of CPUs)
+
+#include "alife_internal.h"
+
+static const char* pin_strategy_names[PIN_STRATEGY_COUNT] = { "none", "compact", "scatter" };
+
+// --- Worker Pool ---
+
+// Starts thread_count - 1 worker threads and pins the calling thread as thread 0; returns 0 on failure
+int start_worker_pool(WorkerPool* pool) {
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->start_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+    pool->shutdown = 0;
+    pool->generation = 0;
+    pool->worker_count = 0;
+    pin_current_thread(pool, 0);
+    for (int i = 1; i < pool->thread_count; ++i) {
+        WorkerThread* worker = &pool->workers[pool->worker_count];
+        worker->pool = pool;
+        worker->index = i;
+        if (pthread_create(&worker->thread, NULL, worker_main, worker) != 0) {
+            fprintf(stderr, "Could not start worker thread %d!\n", i);
+            stop_worker_pool(pool);
+            return 0;
+        }
+        pool->worker_count++;
+    }
+    return 1;
+}
+
+// Stops and joins all worker threads
+void stop_worker_pool(WorkerPool* pool) {
+    pthread_mutex_lock(&pool->mutex);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->start_cond);
+    pthread_mutex_unlock(&pool->mutex);
+    for (int i = 0; i < pool->worker_count; ++i) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+    pool->worker_count = 0;
+    pthread_cond_destroy(&pool->done_cond);
+    pthread_cond_destroy(&pool->start_cond);
+    pthread_mutex_destroy(&pool->mutex);
+}
+
+// Worker thread: waits for a parallel_for, takes chunks until none are left, reports back
+void* worker_main(void* arg) {
+    WorkerThread* worker = (WorkerThread*)arg;
+    WorkerPool* pool = worker->pool;
+    pin_current_thread(pool, worker->index);
+    long seen_generation = 0;
+
+    pthread_mutex_lock(&pool->mutex);
+    for (;;) {
+        while (pool->generation == seen_generation && !pool->shutdown) {
+            pthread_cond_wait(&pool->start_cond, &pool->mutex);
+        }
+        if (pool->shutdown) {
+            break;
+        }
+        seen_generation = pool->generation;
+        current_phase = pool->phase;
+#ifdef ALIFE_TRACK_ALLOCS
+        alloc_step_counters = pool->alloc_step;
+#endif
+        pthread_mutex_unlock(&pool->mutex);
+
+        run_pool_chunks(pool);
+        current_phase = PHASE_COUNT;
+#ifdef ALIFE_TRACK_ALLOCS
+        alloc_step_counters = NULL;
+#endif
+
+        pthread_mutex_lock(&pool->mutex);
+        if (--pool->busy == 0) {
+            pthread_cond_signal(&pool->done_cond);
+        }
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+// Pins the calling thread according to the pool's pin strategy (Linux only; elsewhere a no-op)
+void pin_current_thread(const WorkerPool* pool, int thread_index) {
+    pin_thread(pool->pin_strategy, thread_index, pool->thread_count);
+}
+
+// Pins the calling thread as thread thread_index of thread_count placed with strategy
+void pin_thread(PinStrategy strategy, int thread_index, int thread_count) {
+#ifdef __linux__
+    if (strategy == PIN_NONE) {
+        return;
+    }
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 1) {
+        return;
+    }
+    long cpu = thread_index % cpus;
+    if (strategy == PIN_SCATTER) {
+        long stride = cpus / thread_count > 1 ? cpus / thread_count : 1;
+        cpu = (thread_index * stride) % cpus;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET((int)cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)strategy;
+    (void)thread_index;
+    (void)thread_count;
+#endif
+}
+
+// Returns the PinStrategy with the given name, or -1
+int parse_pin_strategy(const char* name) {
+    for (int i = 0; i < PIN_STRATEGY_COUNT; ++i) {
+        if (strcmp(pin_strategy_names[i], name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Returns the name of a pin strategy
+const char* pin_strategy_name(PinStrategy strategy) {
+    return strategy >= PIN_NONE && strategy < PIN_STRATEGY_COUNT ? pin_strategy_names[strategy] : "?";
+}
+
+// Runs chunks of the current task until all items are taken
+void run_pool_chunks(WorkerPool* pool) {
+    for (;;) {
+        int begin = atomic_fetch_add(&pool->next_item, pool->task_chunk);
+        if (begin >= pool->items) {
+            break;
+        }
+        int end = begin + pool->task_chunk < pool->items ? begin + pool->task_chunk : pool->items;
+        pool->task(pool->task_world, begin, end);
+    }
+}
+
+// Runs task over [0, items) of world in chunks on the calling thread and all workers; returns when done
+void parallel_for(World* world, int items, void (*task)(World* world, int begin, int end)) {
+    parallel_for_blocks(world, items, world->pool.chunk_size, task);
+}
+
+// parallel_for with chunks of block items instead of the pool's chunk size, for tasks whose items
+// are not life forms (e.g. the rows of a grid)
+void parallel_for_blocks(World* world, int items, int block, void (*task)(World* world, int begin, int end)) {
+    WorkerPool* pool = &world->pool;
+    pthread_mutex_lock(&pool->mutex);
+    pool->task = task;
+    pool->task_world = world;
+    pool->items = items;
+    pool->task_chunk = block;
+    pool->phase = current_phase;
+#ifdef ALIFE_TRACK_ALLOCS
+    pool->alloc_step = alloc_current_step();
+#endif
+    atomic_store(&pool->next_item, 0);
+    pool->busy = pool->worker_count;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start_cond);
+    pthread_mutex_unlock(&pool->mutex);
+
+    run_pool_chunks(pool);
+
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->busy > 0) {
+        pthread_cond_wait(&pool->done_cond, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+}
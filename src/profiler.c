@@ -0,0 +1,208 @@
+#define _GNU_SOURCE // For dladdr and REG_RIP
+#include <stdio.h>    // For the report (fprintf) and addr2line (popen)
+#include <stdlib.h>   // For malloc, free, qsort
+#include <string.h>   // For memset, strcmp
+
+#include "alife_internal.h"
+
+#ifdef ALIFE_PROFILER
+#include <signal.h>   // For the SIGPROF handler
+#include <sys/time.h> // For setitimer (ITIMER_PROF)
+#include <ucontext.h> // For the interrupted program counter
+#include <dlfcn.h>    // For dladdr (symbolization)
+
+// One profiler sample: where the program was and which simulation phase it was in
+typedef struct {
+    void* pc;
+    int phase;
+} ProfileSample;
+
+// Samples attributed to one function in the profiler report
+typedef struct {
+    char name[256];
+    long count;
+} ProfileEntry;
+
+// Sampling profiler state. The SIGPROF handler claims a slot with one atomic increment,
+// so recording is lock-free and async-signal-safe.
+static int profiler_hz = 0;
+static ProfileSample* profiler_samples = NULL;
+static atomic_long profiler_next_sample;
+
+void profiler_signal_handler(int sig, siginfo_t* info, void* context);
+void profiler_symbolize(void* pc, char* name, size_t size);
+int compare_samples_by_pc(const void* a, const void* b);
+int compare_entries_by_count(const void* a, const void* b);
+
+// --- Sampling Profiler ---
+// A CPU-time interval timer (ITIMER_PROF) delivers SIGPROF to whichever thread is running; the
+// handler records the interrupted program counter and the current phase. Everything else
+// (symbolization, aggregation) happens in alife_profiler_report after the timer is stopped.
+
+// Allocates the sample buffer, installs the SIGPROF handler and starts the timer; returns 0 on failure
+int alife_profiler_start(int hz) {
+    profiler_samples = (ProfileSample*)malloc(PROFILER_MAX_SAMPLES * sizeof(ProfileSample));
+    if (profiler_samples == NULL) {
+        fprintf(stderr, "Memory allocation failed for profiler samples!\n");
+        return 0;
+    }
+    atomic_store(&profiler_next_sample, 0);
+    profiler_hz = hz;
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = profiler_signal_handler;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+
+    struct itimerval timer;
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = 1000000 / profiler_hz > 0 ? 1000000 / profiler_hz : 1;
+    timer.it_value = timer.it_interval;
+    if (sigaction(SIGPROF, &action, NULL) != 0 || setitimer(ITIMER_PROF, &timer, NULL) != 0) {
+        fprintf(stderr, "Could not start the profiler timer!\n");
+        free(profiler_samples);
+        profiler_samples = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+// Stops the timer and restores the default SIGPROF disposition; samples are kept for the report
+void alife_profiler_stop() {
+    struct itimerval timer;
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_PROF, &timer, NULL);
+    signal(SIGPROF, SIG_IGN);
+}
+
+// SIGPROF handler: records the interrupted program counter and phase in the next free slot
+void profiler_signal_handler(int sig, siginfo_t* info, void* context) {
+    (void)sig;
+    (void)info;
+    long slot = atomic_fetch_add(&profiler_next_sample, 1);
+    if (slot >= PROFILER_MAX_SAMPLES) {
+        return; // Buffer full; the report counts these as dropped
+    }
+    ucontext_t* uc = (ucontext_t*)context;
+    void* pc = NULL;
+#if defined(__x86_64__)
+    pc = (void*)uc->uc_mcontext.gregs[REG_RIP];
+#elif defined(__i386__)
+    pc = (void*)uc->uc_mcontext.gregs[REG_EIP];
+#elif defined(__aarch64__)
+    pc = (void*)uc->uc_mcontext.pc;
+#else
+    (void)uc; // Unknown architecture: phases are still attributed
+#endif
+    profiler_samples[slot].pc = pc;
+    profiler_samples[slot].phase = current_phase;
+}
+
+// Names the function containing pc: the symbol from dladdr (link with -rdynamic so the
+// executable's own functions, including the statically linked library, are visible), else addr2line on the module, else module+offset
+void profiler_symbolize(void* pc, char* name, size_t size) {
+    Dl_info info;
+    if (pc == NULL || dladdr(pc, &info) == 0 || info.dli_fname == NULL) {
+        snprintf(name, size, "[unknown]");
+        return;
+    }
+    if (info.dli_sname != NULL) {
+        snprintf(name, size, "%s", info.dli_sname);
+        return;
+    }
+
+    unsigned long offset = (unsigned long)((char*)pc - (char*)info.dli_fbase);
+    char command[512];
+    snprintf(command, sizeof(command), "addr2line -f -e '%s' 0x%lx 2>/dev/null", info.dli_fname, offset);
+    FILE* pipe = popen(command, "r");
+    if (pipe != NULL) {
+        char function[256];
+        int found = fgets(function, sizeof(function), pipe) != NULL && function[0] != '?';
+        pclose(pipe);
+        if (found) {
+            function[strcspn(function, "\n")] = '\0';
+            snprintf(name, size, "%s", function);
+            return;
+        }
+    }
+    const char* module = strrchr(info.dli_fname, '/') != NULL ? strrchr(info.dli_fname, '/') + 1 : info.dli_fname;
+    snprintf(name, size, "%s+0x%lx", module, offset);
+}
+
+// qsort comparators: samples by program counter, entries by descending count
+int compare_samples_by_pc(const void* a, const void* b) {
+    char* pa = (char*)((const ProfileSample*)a)->pc;
+    char* pb = (char*)((const ProfileSample*)b)->pc;
+    return pa < pb ? -1 : pa > pb;
+}
+
+int compare_entries_by_count(const void* a, const void* b) {
+    long ca = ((const ProfileEntry*)a)->count;
+    long cb = ((const ProfileEntry*)b)->count;
+    return ca > cb ? -1 : ca < cb;
+}
+
+// Prints the top functions and the phases by sample count, then frees the samples
+void alife_profiler_report(FILE* out) {
+    long recorded = atomic_load(&profiler_next_sample);
+    long dropped = recorded > PROFILER_MAX_SAMPLES ? recorded - PROFILER_MAX_SAMPLES : 0;
+    long count = recorded - dropped;
+
+    fprintf(out, "Profile: %ld samples at %d Hz (%.2f s of CPU time)", count, profiler_hz, (double)count / profiler_hz);
+    if (dropped > 0) {
+        fprintf(out, ", %ld dropped (buffer full)", dropped);
+    }
+    fprintf(out, "\n");
+    if (count == 0) {
+        free(profiler_samples);
+        profiler_samples = NULL;
+        return;
+    }
+
+    long phase_counts[PHASE_COUNT + 1] = { 0 };
+    for (long i = 0; i < count; ++i) {
+        phase_counts[profiler_samples[i].phase]++;
+    }
+
+    // Symbolize each distinct program counter once and merge samples per function
+    qsort(profiler_samples, (size_t)count, sizeof(ProfileSample), compare_samples_by_pc);
+    ProfileEntry* entries = (ProfileEntry*)calloc((size_t)count, sizeof(ProfileEntry));
+    int entry_count = 0;
+    for (long i = 0; entries != NULL && i < count;) {
+        long run = 1;
+        while (i + run < count && profiler_samples[i + run].pc == profiler_samples[i].pc) {
+            run++;
+        }
+        char name[256];
+        profiler_symbolize(profiler_samples[i].pc, name, sizeof(name));
+        int e = 0;
+        while (e < entry_count && strcmp(entries[e].name, name) != 0) {
+            e++;
+        }
+        if (e == entry_count) {
+            snprintf(entries[entry_count++].name, sizeof(entries[0].name), "%s", name);
+        }
+        entries[e].count += run;
+        i += run;
+    }
+
+    if (entries != NULL) {
+        qsort(entries, (size_t)entry_count, sizeof(ProfileEntry), compare_entries_by_count);
+        fprintf(out, "  %8s %7s  %s\n", "samples", "share", "function");
+        for (int e = 0; e < entry_count && e < PROFILER_TOP_FUNCTIONS; ++e) {
+            fprintf(out, "  %8ld %6.1f%%  %s\n", entries[e].count, 100.0 * entries[e].count / count, entries[e].name);
+        }
+        free(entries);
+    }
+
+    fprintf(out, "  %8s %7s  %s\n", "samples", "share", "phase");
+    for (int p = 0; p <= PHASE_COUNT; ++p) {
+        fprintf(out, "  %8ld %6.1f%%  %s\n", phase_counts[p], 100.0 * phase_counts[p] / count,
+                p < PHASE_COUNT ? world_phase_name(p) : "(outside steps)");
+    }
+
+    free(profiler_samples);
+    profiler_samples = NULL;
+}
+#endif
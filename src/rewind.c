@@ -0,0 +1,326 @@
+#include <stdio.h>    // For error messages (fprintf)
+#include <stdlib.h>   // For malloc, free
+#include <string.h>   // For memset, memcpy
+
+#include "alife_internal.h"
+
+// --- Rewind Buffer ---
+// Every step appends the new state as one record. A keyframe holds the whole state; the other
+// records hold only its difference to the state before. The difference is taken per 8-byte word
+// as an XOR, which leaves the leading bytes of a slightly moved coordinate and every unchanged
+// field zero, and stored as a mask byte naming the word's non-zero bytes followed by those bytes.
+// A keyframe is the same encoding against an all-zero state. Records are only dropped a whole
+// keyframe group at a time, so the oldest record is always a keyframe and every record decodes.
+// A food field's cells and then the scent cells follow the food, encoded the same way.
+
+#define REWIND_ALIGN 8 // Records start on 8-byte boundaries
+
+// Header of a record; the encoded life forms, food, field and scent cells follow it
+typedef struct {
+    size_t size;                // Bytes of the record, header included, rounded up to REWIND_ALIGN
+    size_t prev;                // Offset of the record before (meaningless for the oldest)
+    long long step;
+    unsigned long long rng_state;
+    int life_form_count;
+    int food_count;
+    int keyframe;
+    WorldParams params;
+    EcologyParams ecology;
+} RewindRecord;
+
+_Static_assert(sizeof(LifeForm) % 8 == 0 && sizeof(Food) % 8 == 0, "entities are encoded as 8-byte words");
+
+static size_t align_up(size_t n) {
+    return (n + REWIND_ALIGN - 1) & ~(size_t)(REWIND_ALIGN - 1);
+}
+
+static RewindRecord* record_at(const RewindBuffer* rb, size_t offset) {
+    return (RewindRecord*)(rb->arena + offset);
+}
+
+// Largest possible record: a keyframe of a full world, every byte non-zero
+static size_t max_record_size(const World* world) {
+    size_t words = ((size_t)world->max_life_forms * sizeof(LifeForm) + (size_t)world->max_food_sources * sizeof(Food)
+                    + field_bytes(world) + scent_bytes(world)) / 8;
+    return align_up(sizeof(RewindRecord) + words * 9);
+}
+
+// Encodes cur (cur_len bytes) against prev (prev_len bytes, zero beyond) at out; returns the bytes written
+static size_t encode_words(unsigned char* out, const unsigned char* cur, size_t cur_len, const unsigned char* prev,
+                           size_t prev_len) {
+    unsigned char* p = out;
+    for (size_t w = 0; w < cur_len; w += 8) {
+        unsigned char* mask = p++;
+        *mask = 0;
+        for (int b = 0; b < 8; ++b) {
+            unsigned char x = cur[w + b] ^ (w < prev_len ? prev[w + b] : 0);
+            if (x != 0) {
+                *mask |= (unsigned char)(1 << b);
+                *p++ = x;
+            }
+        }
+    }
+    return (size_t)(p - out);
+}
+
+// Applies encoded words to dst, which holds the previous state (prev_len bytes, zero beyond);
+// returns the bytes read
+static size_t decode_words(const unsigned char* in, unsigned char* dst, size_t len, size_t prev_len) {
+    const unsigned char* p = in;
+    for (size_t w = 0; w < len; w += 8) {
+        if (w >= prev_len) {
+            memset(dst + w, 0, 8);
+        }
+        unsigned char mask = *p++;
+        for (int b = 0; mask != 0; ++b, mask >>= 1) {
+            if (mask & 1) {
+                dst[w + b] ^= *p++;
+            }
+        }
+    }
+    return (size_t)(p - in);
+}
+
+// Drops the oldest record
+static void drop_oldest(RewindBuffer* rb) {
+    rb->start += record_at(rb, rb->start)->size;
+    rb->count--;
+    if (rb->count == 0) {
+        rb->start = rb->end = 0;
+        rb->wrapped = 0;
+    } else if (rb->wrapped && rb->start == rb->wrap_end) {
+        rb->start = 0;
+        rb->wrapped = 0;
+    }
+}
+
+// Drops the oldest records until bytes contiguous bytes are free at the end; returns their offset.
+// Then drops deltas until the oldest record is a keyframe again.
+static size_t reserve(RewindBuffer* rb, size_t bytes) {
+    for (;;) {
+        if (!rb->wrapped) {
+            if (rb->end + bytes <= rb->capacity) {
+                break;
+            }
+            // Wrap: the records in use then end at wrap_end and continue at the start of the arena
+            rb->wrap_end = rb->end;
+            rb->end = 0;
+            rb->wrapped = rb->count > 0;
+            if (!rb->wrapped) {
+                rb->start = 0;
+            }
+        }
+        if (rb->end + bytes <= rb->start) {
+            break;
+        }
+        drop_oldest(rb); // Unwraps once the records before the wrap are all dropped
+    }
+    size_t offset = rb->end;
+    while (rb->count > 0 && !record_at(rb, rb->start)->keyframe) {
+        drop_oldest(rb);
+    }
+    return offset;
+}
+
+// Offset of the record after the one at offset
+static size_t next_record(const RewindBuffer* rb, size_t offset) {
+    size_t next = offset + record_at(rb, offset)->size;
+    return rb->wrapped && next == rb->wrap_end ? 0 : next;
+}
+
+// Discards the records after the cursor, so the next record continues from the current state
+static void truncate_after_cursor(RewindBuffer* rb) {
+    const RewindRecord* cursor = record_at(rb, rb->cursor);
+    rb->count -= record_at(rb, rb->newest)->step - cursor->step;
+    if (rb->wrapped && rb->cursor >= rb->start) {
+        rb->wrapped = 0; // Everything after the wrap was after the cursor
+    }
+    rb->end = rb->cursor + cursor->size;
+    rb->newest = rb->cursor;
+}
+
+// Appends the world's state after a step; called by finish_step
+void record_rewind_state(World* world) {
+    RewindBuffer* rb = &world->rewind;
+    if (rb->count > 0 && rb->cursor != rb->newest) {
+        truncate_after_cursor(rb);
+    }
+    int keyframe = rb->count == 0 || rb->since_keyframe + 1 >= rb->keyframe_interval;
+    size_t prev = rb->newest;
+    size_t offset = reserve(rb, max_record_size(world));
+    if (rb->count == 0) {
+        keyframe = 1; // Everything was dropped to make room
+    }
+
+    RewindRecord* record = record_at(rb, offset);
+    record->prev = prev;
+    record->step = world->step;
+    record->rng_state = world->rng_state;
+    record->life_form_count = world->life_form_count;
+    record->food_count = world->food_count;
+    record->keyframe = keyframe;
+    record->params = world->params;
+    record->ecology = world->ecology;
+    const StateSnapshot* last = &rb->last;
+    unsigned char* p = (unsigned char*)(record + 1);
+    p += encode_words(p, (const unsigned char*)world->life_forms, world->life_form_count * sizeof(LifeForm),
+                      (const unsigned char*)last->life_forms, keyframe ? 0 : last->life_form_count * sizeof(LifeForm));
+    p += encode_words(p, (const unsigned char*)world->food_sources, world->food_count * sizeof(Food),
+                      (const unsigned char*)last->food_sources, keyframe ? 0 : last->food_count * sizeof(Food));
+    p += encode_words(p, (const unsigned char*)world->field.cells, field_bytes(world),
+                      (const unsigned char*)last->field_cells, keyframe ? 0 : field_bytes(world));
+    p += encode_words(p, (const unsigned char*)world->scent.cells, scent_bytes(world),
+                      (const unsigned char*)last->scent_cells, keyframe ? 0 : scent_bytes(world));
+    record->size = align_up((size_t)(p - (unsigned char*)record));
+
+    rb->end = offset + record->size;
+    rb->count++;
+    rb->newest = rb->cursor = offset;
+    rb->since_keyframe = keyframe ? 0 : rb->since_keyframe + 1;
+    save_snapshot(world, &rb->last);
+}
+
+// Applies a record to the world, whose state must be the record before it (unless it is a keyframe)
+static void apply_record(World* world, const RewindRecord* record) {
+    const unsigned char* p = (const unsigned char*)(record + 1);
+    size_t prev_life_forms = record->keyframe ? 0 : world->life_form_count * sizeof(LifeForm);
+    size_t prev_food = record->keyframe ? 0 : world->food_count * sizeof(Food);
+    p += decode_words(p, (unsigned char*)world->life_forms, record->life_form_count * sizeof(LifeForm), prev_life_forms);
+    p += decode_words(p, (unsigned char*)world->food_sources, record->food_count * sizeof(Food), prev_food);
+    p += decode_words(p, (unsigned char*)world->field.cells, field_bytes(world), record->keyframe ? 0 : field_bytes(world));
+    decode_words(p, (unsigned char*)world->scent.cells, scent_bytes(world), record->keyframe ? 0 : scent_bytes(world));
+    world->life_form_count = record->life_form_count;
+    world->food_count = record->food_count;
+    world->rng_state = record->rng_state;
+    world->step = record->step;
+    world->ecology = record->ecology;
+    if (!params_match(&world->params, &record->params) || !params_match(&record->params, &world->params)) {
+        world->kernels = select_kernels(&record->params, world->specialized);
+    }
+    world->params = record->params;
+}
+
+// Makes the record at offset, just applied, the cursor
+static void move_cursor(World* world, size_t offset) {
+    RewindBuffer* rb = &world->rewind;
+    world->pending_changes = 0; // Scheduled for the state moved away from
+    world->state_version++;
+    rb->cursor = offset;
+    save_snapshot(world, &rb->last);
+}
+
+// --- Rewind API ---
+
+// Allocates (or, with 0 bytes, frees) the rewind buffer; the current state becomes its first record.
+// Returns 0 (after printing why) if the budget cannot hold a few full states or allocation fails.
+int world_enable_rewind(World* world, size_t budget_bytes, int keyframe_interval) {
+    free_rewind_buffer(world);
+    if (budget_bytes == 0) {
+        return 1;
+    }
+    if (keyframe_interval < 1 || budget_bytes < 4 * max_record_size(world)) {
+        fprintf(stderr, "The rewind buffer needs a keyframe interval of at least 1 and at least %zu bytes\n",
+                4 * max_record_size(world));
+        return 0;
+    }
+    RewindBuffer* rb = &world->rewind;
+    rb->arena = (unsigned char*)sim_malloc(budget_bytes);
+    rb->chain = (size_t*)sim_malloc(keyframe_interval * sizeof(size_t));
+    if (rb->arena == NULL || rb->chain == NULL || !allocate_snapshot(world, &rb->last)) {
+        fprintf(stderr, "Memory allocation failed for the rewind buffer!\n");
+        free_rewind_buffer(world);
+        return 0;
+    }
+    rb->capacity = budget_bytes;
+    rb->keyframe_interval = keyframe_interval;
+    record_rewind_state(world);
+    return 1;
+}
+
+// Frees the rewind buffer
+void free_rewind_buffer(World* world) {
+    RewindBuffer* rb = &world->rewind;
+    sim_free(rb->arena);
+    sim_free(rb->chain);
+    free_snapshot(&rb->last);
+    memset(rb, 0, sizeof(*rb));
+}
+
+// Empties the rewind buffer; the current state becomes its first record
+void reset_rewind_buffer(World* world) {
+    RewindBuffer* rb = &world->rewind;
+    rb->start = rb->end = 0;
+    rb->wrapped = 0;
+    rb->count = 0;
+    rb->since_keyframe = 0;
+    record_rewind_state(world);
+}
+
+// Goes back up to steps steps; returns the steps gone back
+long long world_rewind(World* world, long long steps) {
+    RewindBuffer* rb = &world->rewind;
+    long long depth = world_rewind_depth(world);
+    if (steps > depth) {
+        steps = depth;
+    }
+    if (steps <= 0) {
+        return 0;
+    }
+    size_t target = rb->cursor;
+    for (long long i = 0; i < steps; ++i) {
+        target = record_at(rb, target)->prev;
+    }
+    // Decode from the keyframe at or before the target
+    int length = 0;
+    for (size_t offset = target;; offset = record_at(rb, offset)->prev) {
+        rb->chain[length++] = offset;
+        if (record_at(rb, offset)->keyframe) {
+            break;
+        }
+    }
+    for (int i = length - 1; i >= 0; --i) {
+        apply_record(world, record_at(rb, rb->chain[i]));
+    }
+    rb->since_keyframe = length - 1;
+    move_cursor(world, target);
+    return steps;
+}
+
+// Replays up to steps recorded steps after a rewind; returns the steps replayed
+long long world_forward(World* world, long long steps) {
+    RewindBuffer* rb = &world->rewind;
+    long long depth = world_forward_depth(world);
+    if (steps > depth) {
+        steps = depth;
+    }
+    if (steps <= 0) {
+        return 0;
+    }
+    size_t offset = rb->cursor;
+    for (long long i = 0; i < steps; ++i) {
+        offset = next_record(rb, offset);
+        const RewindRecord* record = record_at(rb, offset);
+        apply_record(world, record);
+        rb->since_keyframe = record->keyframe ? 0 : rb->since_keyframe + 1;
+    }
+    move_cursor(world, offset);
+    return steps;
+}
+
+long long world_rewind_depth(const World* world) {
+    const RewindBuffer* rb = &world->rewind;
+    return rb->count > 0 ? record_at(rb, rb->cursor)->step - record_at(rb, rb->start)->step : 0;
+}
+
+long long world_forward_depth(const World* world) {
+    const RewindBuffer* rb = &world->rewind;
+    return rb->count > 0 ? record_at(rb, rb->newest)->step - record_at(rb, rb->cursor)->step : 0;
+}
+
+size_t world_rewind_bytes(const World* world) {
+    const RewindBuffer* rb = &world->rewind;
+    if (rb->count == 0) {
+        return 0;
+    }
+    return rb->wrapped ? rb->wrap_end - rb->start + rb->end : rb->end - rb->start;
+}
@@ -0,0 +1,188 @@
+#include <stdio.h>    // For mismatch reports (fprintf)
+#include <stdlib.h>   // For malloc, free
+#include <string.h>   // For memcpy, memcmp
+#include <math.h>     // For fabs
+
+#include "alife_internal.h"
+
+// --- Validation ---
+// Dual execution: every phase is run by its reference kernel and by its optimized kernel from the
+// same state, and the two results are compared field by field before the step goes on.
+
+// Turns validation on or off for world; snapshots are allocated here, never during a step.
+// Returns 0 on failure.
+int world_set_validation(World* world, ValidationMode mode, double tolerance) {
+    if (tolerance < 0) {
+        fprintf(stderr, "Validation tolerance must not be negative\n");
+        return 0;
+    }
+    if (mode != VALIDATE_OFF && world->validation_before.life_forms == NULL
+        && (!allocate_snapshot(world, &world->validation_before)
+            || !allocate_snapshot(world, &world->validation_reference))) {
+        fprintf(stderr, "Memory allocation failed for validation snapshots!\n");
+        free_snapshot(&world->validation_before);
+        return 0;
+    }
+    world->validation_mode = mode;
+    world->validation_tolerance = tolerance;
+    return 1;
+}
+
+// Allocates a snapshot at the world's capacities; returns 0 on failure
+int allocate_snapshot(const World* world, StateSnapshot* snapshot) {
+    snapshot->life_forms = (LifeForm*)sim_malloc(world->max_life_forms * sizeof(LifeForm));
+    snapshot->food_sources = (Food*)sim_malloc(world->max_food_sources * sizeof(Food));
+    snapshot->field_cells = field_bytes(world) > 0 ? (float*)sim_malloc(field_bytes(world)) : NULL;
+    snapshot->scent_cells = scent_bytes(world) > 0 ? (float*)sim_malloc(scent_bytes(world)) : NULL;
+    if (snapshot->life_forms == NULL || snapshot->food_sources == NULL
+        || (field_bytes(world) > 0 && snapshot->field_cells == NULL)
+        || (scent_bytes(world) > 0 && snapshot->scent_cells == NULL)) {
+        free_snapshot(snapshot);
+        return 0;
+    }
+    return 1;
+}
+
+// Frees a snapshot's arrays
+void free_snapshot(StateSnapshot* snapshot) {
+    sim_free(snapshot->life_forms);
+    sim_free(snapshot->food_sources);
+    sim_free(snapshot->field_cells);
+    sim_free(snapshot->scent_cells);
+    snapshot->life_forms = NULL;
+    snapshot->food_sources = NULL;
+    snapshot->field_cells = NULL;
+    snapshot->scent_cells = NULL;
+}
+
+// Copies the world's state into snapshot
+void save_snapshot(const World* world, StateSnapshot* snapshot) {
+    memcpy(snapshot->life_forms, world->life_forms, world->life_form_count * sizeof(LifeForm));
+    memcpy(snapshot->food_sources, world->food_sources, world->food_count * sizeof(Food));
+    snapshot->life_form_count = world->life_form_count;
+    snapshot->food_count = world->food_count;
+    snapshot->rng_state = world->rng_state;
+    if (world->field.cells != NULL) {
+        memcpy(snapshot->field_cells, world->field.cells, field_bytes(world));
+    }
+    if (world->scent.count > 0) {
+        memcpy(snapshot->scent_cells, world->scent.cells, scent_bytes(world));
+    }
+}
+
+// Replaces the world's state with snapshot
+void restore_snapshot(World* world, const StateSnapshot* snapshot) {
+    memcpy(world->life_forms, snapshot->life_forms, snapshot->life_form_count * sizeof(LifeForm));
+    memcpy(world->food_sources, snapshot->food_sources, snapshot->food_count * sizeof(Food));
+    world->life_form_count = snapshot->life_form_count;
+    world->food_count = snapshot->food_count;
+    world->rng_state = snapshot->rng_state;
+    if (world->field.cells != NULL) {
+        memcpy(world->field.cells, snapshot->field_cells, field_bytes(world));
+    }
+    if (world->scent.count > 0) {
+        memcpy(world->scent.cells, snapshot->scent_cells, scent_bytes(world));
+    }
+}
+
+// Returns 1 if an optimized value is acceptable for the reference value under the validation mode
+int values_match(const World* world, double reference, double optimized) {
+    if (world->validation_mode == VALIDATE_EXACT) {
+        return memcmp(&reference, &optimized, sizeof(double)) == 0; // Also tells -0.0 from 0.0
+    }
+    double scale = fabs(reference) > fabs(optimized) ? fabs(reference) : fabs(optimized);
+    return fabs(reference - optimized) <= world->validation_tolerance * (1.0 + scale);
+}
+
+// Compares one field; prints the mismatch and returns 0 if the values differ
+int check_field(const World* world, const char* entity, int index, const char* field,
+                double reference, double optimized) {
+    if (values_match(world, reference, optimized)) {
+        return 1;
+    }
+    fprintf(stderr, "Validation failed at step %lld, phase %s: %s %d, field %s\n", world->step,
+            world_phase_name(current_phase), entity, index, field);
+    fprintf(stderr, "  reference %.17g (%a)\n  optimized %.17g (%a)\n", reference, reference, optimized, optimized);
+    return 0;
+}
+
+// Compares the world's state with the reference kernel's result; reports the first mismatch and
+// returns 0 if there is one
+int compare_with_snapshot(const World* world, const StateSnapshot* reference) {
+    if (world->life_form_count != reference->life_form_count || world->food_count != reference->food_count) {
+        fprintf(stderr, "Validation failed at step %lld, phase %s: reference has %d life forms and %d food, "
+                "optimized %d and %d\n", world->step, world_phase_name(current_phase), reference->life_form_count,
+                reference->food_count, world->life_form_count, world->food_count);
+        return 0;
+    }
+    for (int i = 0; i < world->life_form_count; ++i) {
+        const LifeForm* a = &reference->life_forms[i];
+        const LifeForm* b = &world->life_forms[i];
+        if (!(check_field(world, "life form", i, "id", a->id, b->id)
+              && check_field(world, "life form", i, "x", a->x, b->x)
+              && check_field(world, "life form", i, "y", a->y, b->y)
+              && check_field(world, "life form", i, "vx", a->vx, b->vx)
+              && check_field(world, "life form", i, "vy", a->vy, b->vy)
+              && check_field(world, "life form", i, "energy", a->energy, b->energy)
+              && check_field(world, "life form", i, "energy_step", (double)a->energy_step, (double)b->energy_step)
+              && check_field(world, "life form", i, "death_step", (double)a->death_step, (double)b->death_step)
+              && check_field(world, "life form", i, "speed_factor", a->speed_factor, b->speed_factor)
+              && check_field(world, "life form", i, "r", a->r, b->r)
+              && check_field(world, "life form", i, "g", a->g, b->g)
+              && check_field(world, "life form", i, "b", a->b, b->b))) {
+            fprintf(stderr, "  (life form id %d)\n", a->id);
+            return 0;
+        }
+    }
+    for (int i = 0; i < world->food_count; ++i) {
+        const Food* a = &reference->food_sources[i];
+        const Food* b = &world->food_sources[i];
+        if (!(check_field(world, "food", i, "x", a->x, b->x)
+              && check_field(world, "food", i, "y", a->y, b->y)
+              && check_field(world, "food", i, "is_present", a->is_present, b->is_present))) {
+            return 0;
+        }
+    }
+    for (int i = 0; world->field.cells != NULL && i < world->field.columns * world->field.rows; ++i) {
+        if (!check_field(world, "field cell", i, "density", reference->field_cells[i], world->field.cells[i])) {
+            return 0;
+        }
+    }
+    for (int i = 0; i < (int)(scent_bytes(world) / sizeof(float)); ++i) {
+        if (!check_field(world, "scent cell", i, "scent", reference->scent_cells[i], world->scent.cells[i])) {
+            return 0;
+        }
+    }
+    if (world->rng_state != reference->rng_state) {
+        fprintf(stderr, "Validation failed at step %lld, phase %s: random generator state differs "
+                "(reference %llx, optimized %llx)\n", world->step, world_phase_name(current_phase),
+                reference->rng_state, world->rng_state);
+        return 0;
+    }
+    return 1;
+}
+
+// Performs one step running every phase through both kernels; returns 0 at the first mismatch.
+// The step continues from the reference result, so small tolerated differences cannot accumulate.
+int validate_step(World* world) {
+    for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+        begin_phase(phase);
+        save_snapshot(world, &world->validation_before);
+        clear_events(world);
+        reference_kernels[phase](world);
+        save_snapshot(world, &world->validation_reference);
+
+        restore_snapshot(world, &world->validation_before);
+        clear_events(world);
+        phase_kernels[phase](world);
+        if (!compare_with_snapshot(world, &world->validation_reference)) {
+            begin_phase(PHASE_COUNT);
+            return 0;
+        }
+        restore_snapshot(world, &world->validation_reference);
+        // Observers see the events of the optimized run once, after it matched the reference
+        notify_phase_observers(world);
+    }
+    finish_step(world);
+    return 1;
+}
@@ -0,0 +1,746 @@
+#define _GNU_SOURCE // For clock_gettime (phase timing)
+#include <stdio.h>    // For error messages (fprintf)
+#include <stdlib.h>   // For dynamic memory allocation (malloc, free)
+#include <string.h>   // For memset
+#include <math.h>     // For fmod (fitting entities into a resized world), ceil (predicting deaths)
+#include <time.h>     // For monotonic timing (clock_gettime)
+#include <limits.h>   // For LLONG_MAX (life forms that never starve)
+
+#include "alife_internal.h"
+
+// Phase the calling thread is executing; PHASE_COUNT outside world_step
+_Thread_local int current_phase = PHASE_COUNT;
+
+static const char* phase_names[PHASE_COUNT] = { "update", "interact", "reproduce" };
+
+const PhaseKernel reference_kernels[PHASE_COUNT] = { update_phase_reference, interact_phase_reference, reproduce_phase_reference };
+const PhaseKernel phase_kernels[PHASE_COUNT] = { update_phase, interact_phase, reproduce_phase };
+
+// --- World Lifetime ---
+
+// Fills config with the default world: the compile-time parameters, one thread, seed 0,
+// specialized kernels where the build has them, the stepped engine, point food
+void world_default_config(WorldConfig* config) {
+    config->max_life_forms = MAX_LIFE_FORMS;
+    config->max_food_sources = MAX_FOOD_SOURCES;
+    config->initial_life_forms = INITIAL_LIFE_FORMS;
+    config->initial_food_sources = INITIAL_FOOD_SOURCES;
+    config->seed = 0;
+    config->threads = 1;
+    config->chunk_size = DEFAULT_CHUNK_SIZE;
+    config->pin = PIN_NONE;
+    default_world_params(&config->params);
+    default_ecology_params(&config->ecology);
+    config->specialized = 1;
+    config->engine = ENGINE_STEPPED;
+    config->food_model = FOOD_POINTS;
+    config->field_columns = (int)(WORLD_WIDTH / FIELD_CELL_SIZE);
+    config->field_rows = (int)(WORLD_HEIGHT / FIELD_CELL_SIZE);
+    config->scent_fields = 0;
+}
+
+// Allocates an empty world at the config's capacities and starts its worker pool; returns NULL on failure
+World* world_allocate(const WorldConfig* config) {
+    if (config->max_life_forms < 1 || config->max_food_sources < 1) {
+        fprintf(stderr, "World capacities must be at least 1\n");
+        return NULL;
+    }
+    if (config->threads < 1 || config->threads > MAX_THREADS) {
+        fprintf(stderr, "Thread count must be between 1 and %d\n", MAX_THREADS);
+        return NULL;
+    }
+    if (config->chunk_size < 1 || config->pin < PIN_NONE || config->pin >= PIN_STRATEGY_COUNT) {
+        fprintf(stderr, "Chunk size must be at least 1 and the pinning strategy valid\n");
+        return NULL;
+    }
+    if (config->engine < ENGINE_STEPPED || config->engine >= ENGINE_COUNT) {
+        fprintf(stderr, "Unknown engine %d\n", (int)config->engine);
+        return NULL;
+    }
+    if (!check_world_params(&config->params) || !check_ecology_params(&config->ecology)
+        || !check_field_config(config)) {
+        return NULL;
+    }
+
+    World* world = (World*)sim_malloc(sizeof(World));
+    if (world == NULL) {
+        fprintf(stderr, "Memory allocation failed for the world!\n");
+        return NULL;
+    }
+    memset(world, 0, sizeof(World));
+    world->max_life_forms = config->max_life_forms;
+    world->max_food_sources = config->max_food_sources;
+    world->params = config->params;
+    world->ecology = config->ecology;
+    world->specialized = config->specialized;
+    world->kernels = select_kernels(&world->params, world->specialized);
+    world->engine = config->engine;
+    world->food_model = config->food_model;
+    if (!allocate_entities(world)) {
+        sim_free(world);
+        return NULL;
+    }
+    if (!allocate_schedules(world)) {
+        release_entities(world);
+        sim_free(world);
+        return NULL;
+    }
+    if (world->food_model == FOOD_FIELD && !allocate_field(world, config->field_columns, config->field_rows)) {
+        free_schedules(world);
+        release_entities(world);
+        sim_free(world);
+        return NULL;
+    }
+    if (!allocate_scent(world, config->scent_fields, config->field_columns, config->field_rows)) {
+        free_field(world);
+        free_schedules(world);
+        release_entities(world);
+        sim_free(world);
+        return NULL;
+    }
+
+    world->pool.thread_count = config->threads;
+    world->pool.chunk_size = config->chunk_size;
+    world->pool.pin_strategy = config->pin;
+    if (!start_worker_pool(&world->pool)) {
+        free_scent(world);
+        free_field(world);
+        free_schedules(world);
+        release_entities(world);
+        sim_free(world);
+        return NULL;
+    }
+    seed_random(world, config->seed);
+    return world;
+}
+
+// Allocates the entity arrays at the world's capacities on the heap; returns 0 (after printing why) on failure
+int allocate_entities(World* world) {
+    world->life_forms = (LifeForm*)sim_malloc(world->max_life_forms * sizeof(LifeForm));
+    world->next_life_forms = (LifeForm*)sim_malloc(world->max_life_forms * sizeof(LifeForm));
+    world->food_sources = (Food*)sim_malloc(world->max_food_sources * sizeof(Food));
+    if (world->life_forms == NULL || world->next_life_forms == NULL || world->food_sources == NULL) {
+        fprintf(stderr, "Memory allocation failed for simulation entities!\n");
+        release_entities(world);
+        return 0;
+    }
+    return 1;
+}
+
+// Frees the entity arrays
+void release_entities(World* world) {
+    sim_free(world->life_forms);
+    sim_free(world->next_life_forms);
+    sim_free(world->food_sources);
+    world->life_forms = world->next_life_forms = NULL;
+    world->food_sources = NULL;
+}
+
+// Creates a world and its initial life forms and food from config; returns NULL on failure
+World* world_create(const WorldConfig* config) {
+    World* world = world_allocate(config);
+    if (world != NULL) {
+        initialize_simulation(world, config->initial_life_forms, config->initial_food_sources);
+    }
+    return world;
+}
+
+// Re-creates the world in place from config, exactly as world_create would, without allocating;
+// e.g. to run many short episodes in one world. Returns 0 (after printing why, leaving the world
+// unchanged) if config is invalid or differs from the world's in capacities, threading, food model
+// or scent fields.
+int world_reset(World* world, const WorldConfig* config) {
+    if (config->max_life_forms != world->max_life_forms || config->max_food_sources != world->max_food_sources
+        || config->threads != world->pool.thread_count || config->chunk_size != world->pool.chunk_size
+        || config->pin != world->pool.pin_strategy || config->food_model != world->food_model
+        || (world->food_model == FOOD_FIELD
+            && (config->field_columns != world->field.columns || config->field_rows != world->field.rows))
+        || config->scent_fields != world->scent.count
+        || (world->scent.count > 0
+            && (config->field_columns != world->scent.columns || config->field_rows != world->scent.rows))) {
+        fprintf(stderr, "A world can only be reset with its own capacities, threading, food field and scent\n");
+        return 0;
+    }
+    if (!check_world_params(&config->params) || !check_ecology_params(&config->ecology)
+        || !world_set_engine(world, config->engine)) {
+        return 0;
+    }
+    world->params = config->params;
+    world->ecology = config->ecology;
+    world->specialized = config->specialized;
+    world->kernels = select_kernels(&world->params, world->specialized);
+    world->pending_changes = 0;
+    world->state_version++;
+    memset(world->phase_time_ns, 0, sizeof(world->phase_time_ns));
+    seed_random(world, config->seed);
+    initialize_simulation(world, config->initial_life_forms, config->initial_food_sources);
+    if (world->rewind.arena != NULL) {
+        reset_rewind_buffer(world);
+    }
+    return 1;
+}
+
+// Stops the world's threads and frees everything it owns
+void world_destroy(World* world) {
+    if (world == NULL) {
+        return;
+    }
+    stop_worker_pool(&world->pool);
+    free_observers(world);
+    free_rewind_buffer(world);
+    free_snapshot(&world->validation_before);
+    free_snapshot(&world->validation_reference);
+    free_schedules(world);
+    free_field(world);
+    free_scent(world);
+    release_entities(world);
+    sim_free(world);
+}
+
+// Marks the start of a simulation phase (PHASE_COUNT = outside world_step)
+void begin_phase(int phase) {
+    current_phase = phase;
+}
+
+// Monotonic wall-clock time in nanoseconds
+double alife_now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// --- Random Numbers ---
+// The simulation uses its own generator instead of rand() so that its state can be
+// saved in a checkpoint and a run resumed (or a captured workload replayed) exactly.
+
+// Seeds the generator; every seed, including 0, gives a valid non-zero state
+void seed_random(World* world, unsigned long long seed) {
+    world->seed = seed;
+    // splitmix64 scrambles consecutive seeds into unrelated states
+    unsigned long long z = seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    world->rng_state = z != 0 ? z : 0x9E3779B97F4A7C15ULL;
+}
+
+// Returns 32 random bits (xorshift64*)
+unsigned int random_u32(World* world) {
+    world->rng_state ^= world->rng_state >> 12;
+    world->rng_state ^= world->rng_state << 25;
+    world->rng_state ^= world->rng_state >> 27;
+    return (unsigned int)((world->rng_state * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+// Returns a random number in [0, 1], like (double)rand() / RAND_MAX
+double random_unit(World* world) {
+    return random_u32(world) / 4294967295.0;
+}
+
+// --- Simulation Core ---
+
+// Initializes the life forms and food sources
+void initialize_simulation(World* world, int initial_life_forms, int initial_food_sources) {
+    world->life_form_count = 0;
+    world->food_count = 0;
+    world->step = 0;
+    world->updated = 0;
+
+    for (int i = 0; i < initial_life_forms; ++i) {
+        // Generate random color for each initial life form
+        unsigned char r = random_u32(world) % 256;
+        unsigned char g = random_u32(world) % 256;
+        unsigned char b = random_u32(world) % 256;
+        spawn_life_form(
+            world,
+            random_unit(world) * world->params.width,  // Random X within the world
+            random_unit(world) * world->params.height, // Random Y within the world
+            MAX_ENERGY / 2.0,                   // Half energy
+            1.0,                                // Default speed factor
+            r, g, b
+        );
+    }
+
+    if (world->scent.count > 0) {
+        memset(world->scent.cells, 0, scent_bytes(world)); // No scent laid yet
+    }
+    if (world->food_model == FOOD_FIELD) {
+        initialize_field(world);
+        return; // No food sources
+    }
+    for (int i = 0; i < initial_food_sources; ++i) {
+        spawn_food(
+            world,
+            random_unit(world) * world->params.width,
+            random_unit(world) * world->params.height
+        );
+    }
+}
+
+// Spawns a new life form at a given position with initial properties
+void spawn_life_form(World* world, double x, double y, double energy, double speed_factor,
+                     unsigned char r, unsigned char g, unsigned char b) {
+    if (world->life_form_count < world->max_life_forms) {
+        LifeForm* lf = &world->life_forms[world->life_form_count];
+        lf->x = x;
+        lf->y = y;
+        set_life_form_energy(world, lf, energy);
+        lf->speed_factor = speed_factor;
+        lf->id = world->life_form_count; // Simple ID
+        lf->r = r;
+        lf->g = g;
+        lf->b = b;
+        // Initial random velocity
+        lf->vx = (random_unit(world) - 0.5) * MAX_SPEED * speed_factor;
+        lf->vy = (random_unit(world) - 0.5) * MAX_SPEED * speed_factor;
+        world->life_form_count++;
+    } else {
+        // printf("Max life forms reached! Cannot spawn new life form.\n");
+    }
+}
+
+// Stores lf's energy as of now and predicts when it runs out
+void set_life_form_energy(World* world, LifeForm* lf, double energy) {
+    lf->energy = energy;
+    lf->energy_step = energy_clock(world);
+    predict_death(world, lf);
+}
+
+// Sets lf->death_step from its stored energy: the first step count at which life_form_energy_at is 0,
+// so that the prediction agrees with the value read
+void predict_death(const World* world, LifeForm* lf) {
+    long long clock = lf->energy_step;
+    double loss = world->ecology.energy_loss;
+    double energy = lf->energy;
+    double first = energy - loss; // After the next update
+    if (first > MAX_ENERGY) first = MAX_ENERGY;
+    if (energy <= 0) {
+        lf->death_step = clock;
+    } else if (first <= 0) {
+        lf->death_step = clock + 1;
+    } else if (loss <= 0 || first / loss > 1e15) {
+        lf->death_step = LLONG_MAX; // Never, or not within any run
+    } else {
+        // The energy after 1 + m updates is first - m * loss; find the smallest m that leaves none
+        long long m = (long long)ceil(first / loss);
+        while (m > 0 && first - (double)(m - 1) * loss <= 0) m--;
+        while (first - (double)m * loss > 0) m++;
+        lf->death_step = clock + 1 + m;
+    }
+}
+
+// Spawns a new food source at a given position
+void spawn_food(World* world, double x, double y) {
+    if (world->food_count < world->max_food_sources) {
+        world->food_sources[world->food_count].x = x;
+        world->food_sources[world->food_count].y = y;
+        world->food_sources[world->food_count].is_present = 1; // Mark as present
+        world->food_count++;
+    } else {
+        // printf("Max food sources reached! Cannot spawn new food.\n");
+    }
+}
+
+// Returns 1 if any food source is present
+int any_food_present(const World* world) {
+    for (int i = 0; i < world->food_count; ++i) {
+        if (world->food_sources[i].is_present) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// 1. Updates all life forms (optimized kernel)
+// Seeking food is independent per life form and draws no random numbers, so it runs on the
+// worker pool; without food, life forms wander randomly and the shared generator keeps it serial.
+// With local sensing any life form may see no food, so that stays serial too. Steering in a food
+// field never draws random numbers, and neither does following scent, which comes after either.
+void update_phase(World* world) {
+    void (*update_range)(World* world, int begin, int end) = world->kernels->update_range;
+    int parallel = world->pool.worker_count > 0 && world->life_form_count > world->pool.chunk_size;
+    if (world->food_model == FOOD_FIELD) {
+        update_range = world->kernels->update_field_range;
+    } else if (event_engine_runs(world)) {
+        begin_event_step(world);
+        update_range = world->kernels->update_events_range;
+    }
+    if (parallel && (world->food_model == FOOD_FIELD
+                     || (world->params.sensing == SENSE_GLOBAL && any_food_present(world)))) {
+        parallel_for(world, world->life_form_count, update_range);
+    } else {
+        update_range(world, 0, world->life_form_count);
+    }
+    if (world->scent.count > 0) {
+        if (parallel) {
+            parallel_for(world, world->life_form_count, world->kernels->follow_scent_range);
+        } else {
+            world->kernels->follow_scent_range(world, 0, world->life_form_count);
+        }
+        deposit_scent(world);
+        step_scent(world);
+    }
+    world->updated = 1; // Every energy has now paid this step's loss
+}
+
+// 1. Updates all life forms, one after another, with the generic kernels (reference kernel)
+void update_phase_reference(World* world) {
+    if (world->food_model == FOOD_FIELD) {
+        update_life_form_range_field_generic(world, 0, world->life_form_count);
+    } else {
+        update_life_form_range_generic(world, 0, world->life_form_count);
+    }
+    if (world->scent.count > 0) {
+        follow_scent_range_generic(world, 0, world->life_form_count);
+        deposit_scent(world);
+        step_scent_reference(world);
+    }
+    world->updated = 1;
+}
+
+// 2. Feeding and food respawn, or grazing and the food field's growth, with the world's selected
+// kernels (optimized kernel)
+void interact_phase(World* world) {
+    if (world->food_model == FOOD_FIELD) {
+        world->kernels->graze(world);
+        step_food_field(world);
+    } else if (event_engine_runs(world)) {
+        world->kernels->interact_events(world);
+    } else {
+        world->kernels->interact(world);
+    }
+}
+
+// 2. Feeding and food respawn, or grazing and the food field's growth, with the generic kernels
+// one cell after another (reference kernel)
+void interact_phase_reference(World* world) {
+    if (world->food_model == FOOD_FIELD) {
+        graze_field_generic(world);
+        step_food_field_reference(world);
+    } else {
+        handle_interactions_generic(world);
+    }
+}
+
+// 3. Handles reproduction and death (optimized kernel: skipped by the event-driven engine when
+// no life form can reproduce or die)
+void reproduce_phase(World* world) {
+    if (event_engine_runs(world)) {
+        event_reproduce_phase(world);
+    } else {
+        reproduce_life_forms(world);
+    }
+}
+
+// 3. Handles reproduction and death (reference kernel)
+void reproduce_phase_reference(World* world) {
+    reproduce_life_forms(world);
+}
+
+// Builds the next generation from the living life forms and their offspring, in order: the
+// survivors, then the offspring. It is built in the preallocated scratch array, so steps never allocate.
+void reproduce_life_forms(World* world) {
+    LifeForm* temp_life_forms = world->next_life_forms;
+    int temp_life_form_count = 0;
+    long long clock = energy_clock(world);
+
+    for (int i = 0; i < world->life_form_count; ++i) {
+        LifeForm* lf = &world->life_forms[i];
+
+        // If life form is alive (its predicted death is still ahead), potentially reproduce and add to temp array
+        if (clock < lf->death_step) {
+            // Check if it's ready to reproduce and if there's space for offspring
+            double energy = life_form_energy_at(world, lf, clock);
+            if (energy >= world->ecology.reproduction_threshold && temp_life_form_count + 1 < world->max_life_forms) {
+                set_life_form_energy(world, lf, energy / 2); // Share energy with offspring
+                double new_speed_factor = lf->speed_factor + (random_unit(world) - 0.5) * world->ecology.mutation_width; // Mutation
+                // Clamp speed factor to the ecology's range
+                if (new_speed_factor < world->ecology.min_speed_factor) new_speed_factor = world->ecology.min_speed_factor;
+                if (new_speed_factor > world->ecology.max_speed_factor) new_speed_factor = world->ecology.max_speed_factor;
+
+                // Add parent to temp array
+                if (temp_life_form_count < world->max_life_forms) {
+                    temp_life_forms[temp_life_form_count++] = *lf;
+                }
+
+                // Spawn offspring
+                // Offspring inherits parent's color for simplicity
+                int count_before = world->life_form_count;
+                spawn_life_form(
+                    world,
+                    lf->x + (random_unit(world) - 0.5) * 10.0, // Slightly offset position
+                    lf->y + (random_unit(world) - 0.5) * 10.0,
+                    lf->energy, // Offspring gets half parent's energy
+                    new_speed_factor,
+                    lf->r, lf->g, lf->b
+                );
+                if (world->life_form_count > count_before) {
+                    RECORD_BIRTH(world, lf, &world->life_forms[count_before]);
+                }
+            } else {
+                // If not reproducing, just copy the life form to the new array
+                if (temp_life_form_count < world->max_life_forms) {
+                    temp_life_forms[temp_life_form_count++] = *lf;
+                }
+            }
+        } else {
+            RECORD_DEATH(world, lf);
+        }
+    }
+
+    // Replace old life_forms array with the new one by swapping the two buffers;
+    // the old array becomes next step's scratch array
+    world->next_life_forms = world->life_forms;
+    world->life_forms = temp_life_forms;
+    world->life_form_count = temp_life_form_count; // Update the global count
+}
+
+// Ends a step: reports it to the step observer, advances the step counter, records the new state
+// for rewinding and closes the step's allocation statistics
+void finish_step(World* world) {
+    begin_phase(PHASE_COUNT);
+    notify_step_observer(world);
+    world->step++;
+    world->updated = 0;
+    if (world->rewind.arena != NULL) {
+        record_rewind_state(world);
+    }
+#ifdef ALIFE_TRACK_ALLOCS
+    alloc_end_step();
+#endif
+}
+
+// --- Stepping ---
+
+// Performs one step of the simulation; with validation enabled, every phase also runs through
+// its reference kernel. Returns 0 if validation found a mismatch (the step is then not completed).
+int world_step(World* world) {
+    world->state_version++;
+    if (world->pending_changes != 0) {
+        apply_pending_changes(world);
+    }
+    if (world->validation_mode != VALIDATE_OFF) {
+        return validate_step(world);
+    }
+    for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+        double phase_start = alife_now_ns();
+        begin_phase(phase);
+        clear_events(world);
+        phase_kernels[phase](world);
+        world->phase_time_ns[phase] += alife_now_ns() - phase_start;
+        notify_phase_observers(world);
+    }
+    finish_step(world);
+    return 1;
+}
+
+// Performs up to steps steps in one call, so embedders pay the call overhead once per batch;
+// returns the steps completed, which is less than steps only if validation found a mismatch
+long long world_step_n(World* world, long long steps) {
+    for (long long i = 0; i < steps; ++i) {
+        if (!world_step(world)) {
+            return i;
+        }
+    }
+    return steps;
+}
+
+// --- Runtime Parameters ---
+// Everything derived from the parameters is brought up to date at the step boundary, and only what
+// a change affects: the kernels are reselected only if a parameter they depend on changed, and only
+// entities left outside a shrunken world are moved. The ecology is read directly by the kernels.
+
+// Schedules new world parameters for the next step boundary; returns 0 if they are invalid
+int world_set_params(World* world, const WorldParams* params) {
+    if (!check_world_params(params)) {
+        return 0;
+    }
+    world->pending_params = *params;
+    world->pending_changes |= PENDING_PARAMS;
+    return 1;
+}
+
+// Schedules a new ecology for the next step boundary; returns 0 if it is invalid
+int world_set_ecology(World* world, const EcologyParams* ecology) {
+    if (!check_ecology_params(ecology)) {
+        return 0;
+    }
+    world->pending_ecology = *ecology;
+    world->pending_changes |= PENDING_ECOLOGY;
+    return 1;
+}
+
+// Returns 0 (after printing why) if params or ecology would be rejected by a world
+int world_check_params(const WorldParams* params, const EcologyParams* ecology) {
+    return check_world_params(params) && check_ecology_params(ecology);
+}
+
+// Folds a coordinate outside [0, size) back into it
+static double wrap_coordinate(double v, double size) {
+    v = fmod(v, size);
+    return v < 0 ? v + size : v;
+}
+
+// Moves a life form left outside the world (or, bouncing, with its body across a wall) back in
+static void fit_life_form(const WorldParams* params, LifeForm* lf) {
+    if (params->boundary == BOUNDARY_WRAP) {
+        if (lf->x < 0 || lf->x >= params->width) lf->x = wrap_coordinate(lf->x, params->width);
+        if (lf->y < 0 || lf->y >= params->height) lf->y = wrap_coordinate(lf->y, params->height);
+        return;
+    }
+    double r = params->life_form_radius;
+    if (lf->x < r) lf->x = r;
+    if (lf->x > params->width - r) lf->x = params->width - r;
+    if (lf->y < r) lf->y = r;
+    if (lf->y > params->height - r) lf->y = params->height - r;
+}
+
+// Applies the parameter changes scheduled since the last step
+void apply_pending_changes(World* world) {
+    world->state_version++; // Entities may be rebased or moved
+    if (world->pending_changes & PENDING_ECOLOGY) {
+        // Energies decayed at the old rate until now; store them and predict deaths at the new one
+        int rebase = world->pending_ecology.energy_loss != world->ecology.energy_loss;
+        for (int i = 0; rebase && i < world->life_form_count; ++i) {
+            LifeForm* lf = &world->life_forms[i];
+            lf->energy = life_form_energy_at(world, lf, energy_clock(world));
+            lf->energy_step = energy_clock(world);
+        }
+        world->ecology = world->pending_ecology;
+        for (int i = 0; rebase && i < world->life_form_count; ++i) {
+            set_life_form_energy(world, &world->life_forms[i], world->life_forms[i].energy);
+        }
+    }
+    if (world->pending_changes & PENDING_PARAMS) {
+        WorldParams old = world->params;
+        const WorldParams* params = &world->pending_params;
+        world->params = *params;
+        if (!params_match(&old, params)) {
+            world->kernels = select_kernels(params, world->specialized);
+        }
+        // Entities can only end up outside the world if it shrank, changed policy, or (bouncing)
+        // the life forms grew
+        if (params->width < old.width || params->height < old.height || params->boundary != old.boundary
+            || params->life_form_radius > old.life_form_radius) {
+            for (int i = 0; i < world->life_form_count; ++i) {
+                fit_life_form(params, &world->life_forms[i]);
+            }
+        }
+        if (params->width < old.width || params->height < old.height) {
+            for (int i = 0; i < world->food_count; ++i) {
+                Food* food = &world->food_sources[i];
+                if (food->x >= params->width) food->x = wrap_coordinate(food->x, params->width);
+                if (food->y >= params->height) food->y = wrap_coordinate(food->y, params->height);
+            }
+        }
+    }
+    world->pending_changes = 0;
+}
+
+// --- State Accessors ---
+
+long long world_step_count(const World* world) {
+    return world->step;
+}
+
+unsigned long long world_seed(const World* world) {
+    return world->seed;
+}
+
+int world_life_form_count(const World* world) {
+    return world->life_form_count;
+}
+
+int world_food_count(const World* world) {
+    return world->food_count;
+}
+
+int world_max_life_forms(const World* world) {
+    return world->max_life_forms;
+}
+
+int world_max_food_sources(const World* world) {
+    return world->max_food_sources;
+}
+
+const WorldParams* world_params(const World* world) {
+    return &world->params;
+}
+
+const EcologyParams* world_ecology(const World* world) {
+    return &world->ecology;
+}
+
+const char* world_kernel_name(const World* world) {
+    return world->kernels->name;
+}
+
+const LifeForm* world_life_forms(const World* world) {
+    return world->life_forms;
+}
+
+const Food* world_food(const World* world) {
+    return world->food_sources;
+}
+
+// Copies the life form positions as x, y pairs into xy (room for max life forms)
+int world_copy_positions(const World* world, double* xy, int max) {
+    int count = world->life_form_count < max ? world->life_form_count : max;
+    for (int i = 0; i < count; ++i) {
+        xy[2 * i] = world->life_forms[i].x;
+        xy[2 * i + 1] = world->life_forms[i].y;
+    }
+    return count;
+}
+
+// Returns the energy life_form, one of the world's, has now
+double world_life_form_energy(const World* world, const LifeForm* life_form) {
+    return life_form_energy_at(world, life_form, energy_clock(world));
+}
+
+// Copies the current life form energies into energies (room for max life forms)
+int world_copy_energies(const World* world, double* energies, int max) {
+    int count = world->life_form_count < max ? world->life_form_count : max;
+    for (int i = 0; i < count; ++i) {
+        energies[i] = life_form_energy_at(world, &world->life_forms[i], energy_clock(world));
+    }
+    return count;
+}
+
+// Copies the positions of present food as x, y pairs into xy (room for max food sources)
+int world_copy_food_positions(const World* world, double* xy, int max) {
+    int count = 0;
+    for (int i = 0; i < world->food_count && count < max; ++i) {
+        if (world->food_sources[i].is_present) {
+            xy[2 * count] = world->food_sources[i].x;
+            xy[2 * count + 1] = world->food_sources[i].y;
+            count++;
+        }
+    }
+    return count;
+}
+
+// --- Timing and Threads ---
+
+const double* world_phase_times_ns(const World* world) {
+    return world->phase_time_ns;
+}
+
+void world_reset_phase_times(World* world) {
+    for (int p = 0; p < PHASE_COUNT; ++p) {
+        world->phase_time_ns[p] = 0.0;
+    }
+}
+
+// Name of a phase, or of the time outside steps for PHASE_COUNT
+const char* world_phase_name(int phase) {
+    return phase >= 0 && phase < PHASE_COUNT ? phase_names[phase] : "(outside)";
+}
+
+int world_thread_count(const World* world) {
+    return world->pool.thread_count;
+}
+
+PinStrategy world_pin_strategy(const World* world) {
+    return world->pool.pin_strategy;
+}
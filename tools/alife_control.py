@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+"""Client for the control socket of a headless run (--run --control PATH).
+
+Sends each command, one per line, to the run and prints its reply. Without
+commands, reads them from standard input, one per line.
+
+    tools/alife_control.py /tmp/alife.sock status
+    tools/alife_control.py /tmp/alife.sock pause "checkpoint /tmp/paused.alck" "set energy-loss 0.04" resume
+
+Commands: status, pause, resume, stop, checkpoint PATH, set NAME VALUE (NAME as
+in a parameter file). Exit status: 0 = every reply was ok, 1 = an error reply,
+2 = the socket cannot be reached.
+"""
+
+import argparse
+import socket
+import sys
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("socket", help="control socket path of the run")
+    parser.add_argument("commands", nargs="*", help="commands to send (default: read from standard input)")
+    args = parser.parse_args()
+
+    try:
+        conn = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        conn.connect(args.socket)
+    except OSError as e:
+        print("Could not connect to %s: %s" % (args.socket, e), file=sys.stderr)
+        return 2
+    stream = conn.makefile("rw")
+    failed = False
+    for command in args.commands or (line.strip() for line in sys.stdin):
+        if not command:
+            continue
+        stream.write(command + "\n")
+        stream.flush()
+        reply = stream.readline().rstrip("\n")
+        if not reply:
+            print("The run closed the connection", file=sys.stderr)
+            return 2
+        print(reply)
+        failed = failed or reply.startswith("error")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
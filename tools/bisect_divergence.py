@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+"""Divergence bisection for the artificial life simulator.
+
+Runs two simulator configurations (two binaries, or one binary with different
+options) headless from the same seed and compares state hashes every
+--hash-every steps. Once a pair of hashes differs, the tool resumes each
+configuration from its own checkpoint of the last step where the states agreed
+and bisects down to the first step that diverges. It then prints a field-level
+diff of the parameters, life forms and food sources that differ after that step.
+World and ecology options in a configuration override the parameters of the
+checkpoints it resumes from, so configurations may differ in them too.
+
+    tools/bisect_divergence.py --a ./alife_old --b ./alife_new --scenario large --steps 2000
+    tools/bisect_divergence.py --a "./alife_headless --threads 1" --b "./alife_headless --threads 8"
+
+Exit status: 0 = no divergence, 1 = divergence found, 2 = usage or run error.
+"""
+
+import argparse
+import os
+import shlex
+import subprocess
+import sys
+import tempfile
+
+LIFE_FORM_FIELDS = ["x", "y", "vx", "vy", "energy", "speed_factor", "id", "r", "g", "b", "energy_step"]
+FOOD_FIELDS = ["x", "y", "is_present"]
+
+
+def run(config, options):
+    """Runs one configuration headless; returns {step: hash} from its --hash-every output."""
+    cmd = shlex.split(config)
+    cmd = cmd[:1] + ["--run"] + cmd[1:] + options
+    out = subprocess.run(cmd, check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout
+    hashes = {}
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) == 3 and fields[0] == "hash":
+            hashes[int(fields[1])] = fields[2]
+    return hashes
+
+
+def start_options(args, start):
+    """Options that start a run from a checkpoint, or else from the seeded scenario."""
+    if start is not None:
+        return ["--resume", start]
+    return ["--scenario", args.scenario, "--seed", str(args.seed)]
+
+
+def first_divergence(hashes_a, hashes_b):
+    """(last step both runs agree on, first step they differ at) among the hashed steps, or None."""
+    agreed = None
+    for step in sorted(set(hashes_a) & set(hashes_b)):
+        if hashes_a[step] != hashes_b[step]:
+            return agreed, step
+        agreed = step
+    return None
+
+
+def read_checkpoint(path):
+    """Parses a checkpoint into a header dict, lists of life form and food field tuples and a list of
+    food field and scent cell tuples (empty for point food without scent)."""
+    with open(path) as f:
+        tokens = f.read().split()
+    header = {"magic": tokens[0], "version": tokens[1], "seed": tokens[3], "step": int(tokens[5]), "rng": tokens[7],
+              "capacity": (tokens[9], tokens[10])}
+    pos = 11
+    if tokens[pos] == "params":  # Version 2 and later
+        header["params"] = tuple(tokens[pos + 1:pos + 8])
+        pos += 8
+    if tokens[pos] == "ecology":  # Version 3 and later; version 5 adds the three food field rates, 7 the speed range
+        version = int(header["version"])
+        values = 10 if version >= 7 else 8 if version >= 5 else 5
+        header["ecology"] = tuple(tokens[pos + 1:pos + 1 + values])
+        pos += 1 + values
+    cells = 0
+    if tokens[pos] == "field" and int(header["version"]) == 5:
+        header["field"] = (tokens[pos + 1], tokens[pos + 2])
+        cells = int(tokens[pos + 1]) * int(tokens[pos + 2])
+        pos += 3
+    elif tokens[pos] == "field":  # Version 6 and later name the food model; scent may need the grid too
+        header["field"] = (tokens[pos + 2], tokens[pos + 3])
+        grid = int(tokens[pos + 2]) * int(tokens[pos + 3])
+        scent = int(tokens[pos + 5])
+        header["scent"] = tuple(tokens[pos + 6:pos + 6 + 4 * scent])
+        cells = (grid if tokens[pos + 1] == "field" else 0) + scent * grid
+        pos += 6 + 4 * scent
+    count = int(tokens[pos + 1])
+    pos += 2
+    life_forms = []
+    fields = len(LIFE_FORM_FIELDS) if int(header["version"]) >= 4 else len(LIFE_FORM_FIELDS) - 1
+    for _ in range(count):
+        life_form = tokens[pos:pos + fields]
+        if fields < len(LIFE_FORM_FIELDS):  # Before version 4 energies are as of the checkpoint's step
+            life_form.append(str(header["step"]))
+        life_forms.append(life_form)
+        pos += fields
+    count = int(tokens[pos + 1])
+    pos += 2
+    food = []
+    for _ in range(count):
+        food.append(tokens[pos:pos + len(FOOD_FIELDS)])
+        pos += len(FOOD_FIELDS)
+    field = [tokens[pos + i:pos + i + 1] for i in range(cells)]
+    return header, life_forms, food, field
+
+
+def format_value(token):
+    """Checkpoint values are hex floats or integers; shows them in decimal (with the exact hex for floats)."""
+    if "p" in token:
+        return "%.17g (%s)" % (float.fromhex(token), token)
+    return token
+
+
+def diff_entities(kind, fields, a, b, max_diffs):
+    """Prints the entities whose fields differ; returns how many differ."""
+    differing = 0
+    for index in range(max(len(a), len(b))):
+        if index >= len(a) or index >= len(b):
+            print("  %s %d only exists in %s" % (kind, index, "A" if index < len(a) else "B"))
+            differing += 1
+            continue
+        changed = [i for i, field in enumerate(fields) if a[index][i] != b[index][i]]
+        if not changed:
+            continue
+        differing += 1
+        if differing > max_diffs:
+            continue
+        label = "%s %d" % (kind, index)
+        if "id" in fields:
+            label += " (id %s)" % a[index][fields.index("id")]
+        print("  %s:" % label)
+        for i in changed:
+            print("    %-12s A %s\n    %-12s B %s" % (fields[i], format_value(a[index][i]), "", format_value(b[index][i])))
+    if differing > max_diffs:
+        print("  ... %d more %s(s) differ" % (differing - max_diffs, kind))
+    return differing
+
+
+def diff_checkpoints(path_a, path_b, max_diffs):
+    header_a, life_forms_a, food_a, field_a = read_checkpoint(path_a)
+    header_b, life_forms_b, food_b, field_b = read_checkpoint(path_b)
+    for key in ("params", "ecology", "scent"):
+        if header_a.get(key) != header_b.get(key):
+            print("  %s: A %s\n  %s  B %s" % (key, " ".join(header_a.get(key, ())), " " * len(key),
+                                              " ".join(header_b.get(key, ()))))
+    if header_a["rng"] != header_b["rng"]:
+        print("  random generator state: A %s, B %s" % (header_a["rng"], header_b["rng"]))
+    if len(life_forms_a) != len(life_forms_b) or len(food_a) != len(food_b):
+        print("  counts: A %d life forms / %d food, B %d life forms / %d food"
+              % (len(life_forms_a), len(food_a), len(life_forms_b), len(food_b)))
+    differing = diff_entities("life form", LIFE_FORM_FIELDS, life_forms_a, life_forms_b, max_diffs)
+    differing += diff_entities("food", FOOD_FIELDS, food_a, food_b, max_diffs)
+    differing += diff_entities("grid cell", ["value"], field_a, field_b, max_diffs)  # Food field, then scent
+    print("  %d %s" % (differing, "entity differs" if differing == 1 else "entities differ"))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--a", required=True, help="first configuration: simulator binary plus options, quoted")
+    parser.add_argument("--b", required=True, help="second configuration")
+    parser.add_argument("--scenario", default="default", help="initial world (default: default)")
+    parser.add_argument("--seed", type=int, default=12345, help="random seed (default: 12345)")
+    parser.add_argument("--resume", help="start both runs from this checkpoint instead of a scenario")
+    parser.add_argument("--steps", type=int, default=1000, help="steps to compare (default: 1000)")
+    parser.add_argument("--hash-every", type=int, default=100,
+                        help="steps between compared hashes in the first pass (default: 100)")
+    parser.add_argument("--max-diffs", type=int, default=20, help="differing entities to print (default: 20)")
+    parser.add_argument("--keep", help="keep the checkpoints in this directory instead of a temporary one")
+    args = parser.parse_args()
+
+    if args.steps < 1 or args.hash_every < 1:
+        parser.error("need --steps >= 1 and --hash-every >= 1")
+
+    workdir = args.keep or tempfile.mkdtemp(prefix="alife-bisect-")
+    os.makedirs(workdir, exist_ok=True)
+    try:
+        # First pass: coarse hashes over the whole run
+        options = start_options(args, args.resume) + ["--steps", str(args.steps), "--hash-every", str(args.hash_every)]
+        hashes_a = run(args.a, options)
+        hashes_b = run(args.b, options)
+        found = first_divergence(hashes_a, hashes_b)
+        if found is None:
+            print("No divergence in %d steps (%d hashes compared)" % (args.steps, len(set(hashes_a) & set(hashes_b))))
+            return 0
+        agreed, diverged = found
+
+        # Bisect between the last agreeing and the first differing hash. Every probe resumes each
+        # configuration from its own checkpoint of the last step known to agree: the hash covers the
+        # entities but not the parameters, which are the configuration's.
+        configs = (args.a, args.b)
+        starts = [args.resume, args.resume]
+        start_step = read_checkpoint(args.resume)[0]["step"] if args.resume else 0
+        lo = agreed if agreed is not None else start_step
+        hi = diverged
+        if lo != start_step:
+            checkpoints = [os.path.join(workdir, "agree-%s-%d.alck" % (name, lo)) for name in ("a", "b")]
+            for config, start, checkpoint in zip(configs, starts, checkpoints):
+                run(config, start_options(args, start) + ["--steps", str(lo - start_step),
+                                                          "--capture-at", str(lo), "--capture-out", checkpoint])
+            starts, start_step = checkpoints, lo
+        print("States agree at step %d and differ at step %d; bisecting" % (lo, hi))
+        while hi - lo > 1:
+            mid = (lo + hi) // 2
+            checkpoints = [os.path.join(workdir, "agree-%s-%d.alck" % (name, mid)) for name in ("a", "b")]
+            probe = ["--steps", str(mid - start_step), "--hash-every", str(mid - start_step), "--capture-at", str(mid)]
+            hash_a, hash_b = [run(config, start_options(args, start) + probe + ["--capture-out", checkpoint])[mid]
+                              for config, start, checkpoint in zip(configs, starts, checkpoints)]
+            if hash_a == hash_b:
+                lo, starts, start_step = mid, checkpoints, mid
+            else:
+                hi = mid
+            print("  step %d: %s" % (mid, "agree" if hash_a == hash_b else "differ"))
+
+        # Field-level diff of the state both configurations reach after the first divergent step
+        paths = [os.path.join(workdir, "diverged-%s-%d.alck" % (name, hi)) for name in ("a", "b")]
+        for config, start, path in zip(configs, starts, paths):
+            run(config, start_options(args, start) + ["--steps", str(hi - start_step),
+                                                      "--capture-at", str(hi), "--capture-out", path])
+        print("\nFirst divergent step: %d (step %d agrees)" % (hi, lo))
+        diff_checkpoints(paths[0], paths[1], args.max_diffs)
+        if args.keep:
+            print("\nCheckpoints kept in %s" % workdir)
+        return 1
+    except (OSError, subprocess.CalledProcessError, KeyError) as e:
+        print("Run failed: %s" % e, file=sys.stderr)
+        return 2
+    finally:
+        if not args.keep:
+            for name in os.listdir(workdir):
+                os.remove(os.path.join(workdir, name))
+            os.rmdir(workdir)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
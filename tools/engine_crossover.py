@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""Engine crossover study for the artificial life simulator.
+
+Runs one benchmark scenario with the stepped and the event-driven engine on
+worlds of growing size, so that the same life forms and food spread ever
+thinner, reports the time per step of both engines against the density
+(life forms per million square units) and estimates the crossover density
+below which the event-driven engine is faster.
+
+    tools/engine_crossover.py --binary ./alife_headless
+    tools/engine_crossover.py --binary ./alife_headless --scenario default --scales 1,2,4,8 --json crossover.json
+"""
+
+import argparse
+import json
+import math
+import subprocess
+import sys
+
+from perf_gate import format_ns, summarize
+
+ENGINES = ["stepped", "event"]
+BASE_WORLD = (800, 600)
+
+
+def measure(args, engine, width, height):
+    """Runs the scenario once with one engine; returns (mean, ci) of step_ns, the density and the final populations."""
+    cmd = [args.binary, "--bench", "--scenario", args.scenario, "--runs", str(args.runs),
+           "--engine", engine, "--world", "%dx%d" % (width, height), "--threads", str(args.threads)]
+    if args.steps:
+        cmd += ["--steps", str(args.steps)]
+    out = subprocess.run(cmd, check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout
+    record = json.loads(next(line for line in out.splitlines() if line.startswith("{")))
+    density = record["initial_population"] / record["area"] * 1e6
+    return summarize(record["metrics"]["step_ns"], 0.95), density, sorted(set(record["final_population"]))
+
+
+def study(args):
+    """Measures both engines at every scale; returns a list of per-scale rows, densest first."""
+    rows = []
+    for scale in args.scales:
+        width, height = round(BASE_WORLD[0] * scale), round(BASE_WORLD[1] * scale)
+        row = {"world": "%dx%d" % (width, height), "metrics": {}}
+        populations = {}
+        for engine in ENGINES:
+            (mean, ci), row["density"], populations[engine] = measure(args, engine, width, height)
+            row["metrics"][engine] = {"mean": mean, "ci": ci}
+        if populations["event"] != populations["stepped"]:
+            print("warning: final population differs in a %s world (%s vs %s); the engines do not agree"
+                  % (row["world"], populations["event"], populations["stepped"]), file=sys.stderr)
+        row["speedup"] = row["metrics"]["stepped"]["mean"] / max(row["metrics"]["event"]["mean"], 1e-9)
+        rows.append(row)
+    rows.sort(key=lambda row: -row["density"])
+    return rows
+
+
+def crossover(rows):
+    """Density at which the event-driven engine's speedup crosses 1, interpolated on log scales; None if it never does."""
+    for dense, sparse in zip(rows, rows[1:]):
+        if (dense["speedup"] < 1.0) != (sparse["speedup"] < 1.0):
+            a, b = math.log(dense["speedup"]), math.log(sparse["speedup"])
+            t = a / (a - b)
+            return math.exp(math.log(dense["density"]) + t * (math.log(sparse["density"]) - math.log(dense["density"])))
+    return None
+
+
+def print_table(scenario, rows, density):
+    print("\nScenario: %s" % scenario)
+    header = "%-12s %12s  %-22s %-22s %8s" % ("world", "density/Mu2", "stepped", "event", "speedup")
+    print(header)
+    print("-" * len(header))
+    for row in rows:
+        cells = ["%s +-%s" % (format_ns(row["metrics"][e]["mean"]), format_ns(row["metrics"][e]["ci"])) for e in ENGINES]
+        print("%-12s %12.1f  %-22s %-22s %7.2fx" % (row["world"], row["density"], cells[0], cells[1], row["speedup"]))
+    if density is not None:
+        print("  event-driven engine wins below about %.1f life forms per million square units" % density)
+    elif rows and rows[0]["speedup"] >= 1.0:
+        print("  event-driven engine wins at every density measured")
+    else:
+        print("  stepped engine wins at every density measured")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--binary", required=True, help="simulator executable (headless builds work)")
+    parser.add_argument("--scenario", default="large", help="benchmark scenario (default: large)")
+    parser.add_argument("--scales", default="1,1.5,2,3,4,6,8",
+                        help="comma-separated world scales, relative to %dx%d (default: 1,1.5,2,3,4,6,8)" % BASE_WORLD)
+    parser.add_argument("--threads", type=int, default=1, help="threads of both engines (default: 1)")
+    parser.add_argument("--runs", type=int, default=5, help="timed runs per configuration (default: 5)")
+    parser.add_argument("--steps", type=int, help="override the scenario's step count")
+    parser.add_argument("--json", help="also write the results to this JSON file")
+    args = parser.parse_args()
+
+    try:
+        args.scales = [float(s) for s in args.scales.split(",")]
+    except ValueError:
+        parser.error("--scales expects comma-separated numbers")
+    if args.runs < 2 or args.threads < 1 or min(args.scales) <= 0:
+        parser.error("need --runs >= 2, --threads >= 1 and positive scales")
+
+    try:
+        rows = study(args)
+    except (OSError, subprocess.CalledProcessError) as e:
+        print("Benchmark failed: %s" % e, file=sys.stderr)
+        return 2
+    density = crossover(rows)
+    print_table(args.scenario, rows, density)
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump({"scenario": args.scenario, "rows": rows, "crossover_density": density}, f, indent=2)
+            f.write("\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
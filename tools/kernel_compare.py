@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+"""Specialized vs generic kernel comparison for the artificial life simulator.
+
+Runs the benchmark suite twice per invocation, once with the kernels the build
+specialized for the world's parameters and once with --generic-kernels, and
+prints the mean step and phase times of both with the gain of the specialized
+kernels. World options after "--" are passed to every run, so any parameter set
+in ALIFE_SPECIALIZE can be compared. Both runs must end every scenario with
+the same population, since a specialization must compute exactly what the
+generic kernels compute.
+
+    tools/kernel_compare.py --binary ./alife_headless
+    tools/kernel_compare.py --binary ./alife_headless -- --world 640x480 --boundary wrap
+
+Exit status: 0 = compared, 1 = results differ or no specialization matched, 2 = benchmark error.
+"""
+
+import argparse
+import json
+import subprocess
+import sys
+
+from perf_gate import DEFAULT_WORKLOADS, format_ns, run_suite, suite_commands, summarize
+
+METRICS = ["step_ns", "update_ns", "interact_ns"]
+VARIANTS = [("specialized", []), ("generic", ["--generic-kernels"])]
+
+
+def kernel_names(commands):
+    """Runs the first command for one short step; returns the kernels it reports."""
+    cmd = commands[0][:]
+    cmd[cmd.index("--runs") + 1] = "1"
+    out = subprocess.run(cmd + ["--warmup", "0", "--steps", "1"], check=True, stdout=subprocess.PIPE,
+                         universal_newlines=True).stdout
+    return {json.loads(line)["kernels"] for line in out.splitlines() if line.startswith("{")}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--binary", required=True, help="simulator executable (headless builds work)")
+    parser.add_argument("--scenario", help="only run this scenario (workload:NAME for a captured workload)")
+    parser.add_argument("--workloads", default=DEFAULT_WORKLOADS,
+                        help="directory of captured workloads (*.alck) to replay (default: bench/workloads)")
+    parser.add_argument("--runs", type=int, default=5, help="timed runs per invocation (default: 5)")
+    parser.add_argument("--invocations", type=int, default=3,
+                        help="processes started per variant, interleaved (default: 3)")
+    parser.add_argument("world_options", nargs="*", help="world options passed to every run (after --)")
+    args = parser.parse_args()
+
+    if args.runs < 1 or args.invocations < 1 or args.runs * args.invocations < 2:
+        parser.error("need at least two samples per metric")
+
+    base = suite_commands(args.binary, args.scenario, args.runs, None, args.workloads)
+    commands = {name: [cmd + args.world_options + extra for cmd in base] for name, extra in VARIANTS}
+    results = {name: {} for name, _ in VARIANTS}
+    try:
+        specialized = kernel_names(commands["specialized"])
+        if specialized == {"generic"}:
+            print("The build has no kernels specialized for these world parameters; add them to ALIFE_SPECIALIZE",
+                  file=sys.stderr)
+            return 1
+        for _ in range(args.invocations):
+            for name, _ in VARIANTS:
+                for scenario, entry in run_suite(commands[name], 1).items():
+                    target = results[name].setdefault(scenario, {"samples": {}, "population": set()})
+                    for metric, values in entry["samples"].items():
+                        target["samples"].setdefault(metric, []).extend(values)
+                    target["population"].update(entry["population"])
+    except (OSError, subprocess.CalledProcessError) as e:
+        print("Benchmark failed: %s" % e, file=sys.stderr)
+        return 2
+
+    print("Specialized kernels: %s" % ", ".join(sorted(specialized)))
+    header = "%-20s %-12s  %-20s  %-20s  %s" % ("scenario", "metric", "generic", "specialized", "gain")
+    print(header)
+    print("-" * len(header))
+    status = 0
+    for scenario, entry in results["generic"].items():
+        if results["specialized"][scenario]["population"] != entry["population"]:
+            print("%-20s final population differs: specialized %s, generic %s" % (
+                scenario, sorted(results["specialized"][scenario]["population"]), sorted(entry["population"])))
+            status = 1
+            continue
+        for metric in METRICS:
+            generic_mean, generic_ci = summarize(entry["samples"][metric], 0.95)
+            spec_mean, spec_ci = summarize(results["specialized"][scenario]["samples"][metric], 0.95)
+            print("%-20s %-12s  %-20s  %-20s  %+.1f%%" % (
+                scenario, metric, "%s +/-%.1f%%" % (format_ns(generic_mean), generic_ci / generic_mean * 100),
+                "%s +/-%.1f%%" % (format_ns(spec_mean), spec_ci / spec_mean * 100),
+                (generic_mean / spec_mean - 1.0) * 100.0))
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,229 @@
+#!/usr/bin/env python3
+"""Performance regression gate for the artificial life simulator.
+
+Runs the simulator's headless benchmark suite (``--bench``) and replays the
+captured workloads in bench/workloads several times, computes a mean and
+confidence interval for every metric, compares them with
+the checked-in baseline (bench/baseline.json) and exits non-zero when a metric
+is slower than its tolerance allows even after accounting for measurement noise.
+
+    tools/perf_gate.py --binary ./alife_headless
+    tools/perf_gate.py --binary ./alife_headless --update-baseline
+
+Exit status: 0 = no regression, 1 = regression or changed workload, 2 = usage error.
+"""
+
+import argparse
+import json
+import math
+import os
+import subprocess
+import sys
+
+BENCH_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "bench")
+DEFAULT_BASELINE = os.path.join(BENCH_DIR, "baseline.json")
+DEFAULT_WORKLOADS = os.path.join(BENCH_DIR, "workloads")
+DEFAULT_TOLERANCE = 0.10
+
+# Two-sided Student t critical values, indexed by degrees of freedom (1..30)
+T_CRITICAL = {
+    0.95: [12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+           2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+           2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042],
+    0.99: [63.657, 9.925, 5.841, 4.604, 4.032, 3.707, 3.499, 3.355, 3.250, 3.169,
+           3.106, 3.055, 3.012, 2.977, 2.947, 2.921, 2.898, 2.878, 2.861, 2.845,
+           2.831, 2.819, 2.807, 2.797, 2.787, 2.779, 2.771, 2.763, 2.756, 2.750],
+}
+Z_CRITICAL = {0.95: 1.960, 0.99: 2.576}
+
+
+def summarize(samples, confidence):
+    """Returns (mean, ci_half_width) of the samples."""
+    n = len(samples)
+    mean = sum(samples) / n
+    if n < 2:
+        return mean, float("inf")
+    variance = sum((x - mean) ** 2 for x in samples) / (n - 1)
+    df = n - 1
+    t = T_CRITICAL[confidence][df - 1] if df <= 30 else Z_CRITICAL[confidence]
+    return mean, t * math.sqrt(variance / n)
+
+
+def suite_commands(binary, scenario, runs, seed, workloads_dir):
+    """Benchmark invocations making up the suite: the built-in scenarios, then one per captured workload."""
+    commands = []
+    if not scenario or not scenario.startswith("workload:"):
+        cmd = [binary, "--bench", "--runs", str(runs)]
+        if scenario:
+            cmd += ["--scenario", scenario]
+        if seed is not None:
+            cmd += ["--seed", str(seed)]
+        commands.append(cmd)
+    if workloads_dir and os.path.isdir(workloads_dir):
+        for name in sorted(os.listdir(workloads_dir)):
+            stem = os.path.splitext(name)[0]
+            if name.endswith(".alck") and (not scenario or scenario == "workload:" + stem):
+                commands.append([binary, "--bench", "--runs", str(runs), "--workload", os.path.join(workloads_dir, name)])
+    return commands
+
+
+def run_suite(commands, invocations):
+    """Runs every command `invocations` times; returns {scenario: {"steps", "seed", "samples", "population"}}."""
+    results = {}
+    for cmd in commands * invocations:
+        out = subprocess.run(cmd, check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout
+        for line in out.splitlines():
+            if not line.startswith("{"):
+                continue
+            record = json.loads(line)
+            entry = results.setdefault(record["scenario"], {
+                "steps": record["steps"], "seed": record["seed"], "samples": {}, "population": set()})
+            for metric, values in record["metrics"].items():
+                entry["samples"].setdefault(metric, []).extend(values)
+            entry["population"].update(record["final_population"])
+    return results
+
+
+def classify(base_mean, base_ci, cur_mean, cur_ci, tolerance):
+    """Returns (relative delta, relative noise, status) for one metric."""
+    delta = (cur_mean - base_mean) / base_mean
+    noise = math.sqrt(base_ci ** 2 + cur_ci ** 2) / base_mean
+    if delta - noise > tolerance:
+        return delta, noise, "REGRESSION"
+    if delta + noise < -tolerance:
+        return delta, noise, "improved"
+    if noise > tolerance:
+        return delta, noise, "noisy"
+    return delta, noise, "ok"
+
+
+def metric_tolerance(baseline, base_metric, metric):
+    """Relative tolerance: the metric's own, else the baseline's per-metric default, else the global default."""
+    if "tolerance" in base_metric:
+        return base_metric["tolerance"]
+    return baseline.get("metric_tolerances", {}).get(metric, baseline.get("default_tolerance", DEFAULT_TOLERANCE))
+
+
+def format_ns(value):
+    if value >= 1e6:
+        return "%.2f ms" % (value / 1e6)
+    if value >= 1e3:
+        return "%.2f us" % (value / 1e3)
+    return "%.0f ns" % value
+
+
+def print_table(rows):
+    headers = ["scenario", "metric", "baseline", "current", "delta", "+/-noise", "tol", "status"]
+    widths = [max(len(str(r[i])) for r in rows + [headers]) for i in range(len(headers))]
+    line = "  ".join(h.ljust(w) for h, w in zip(headers, widths))
+    print(line)
+    print("-" * len(line))
+    for row in rows:
+        print("  ".join(str(c).ljust(w) for c, w in zip(row, widths)))
+
+
+def compare(baseline, results, confidence):
+    rows = []
+    failed = False
+    for name, entry in sorted(results.items()):
+        base = baseline.get("scenarios", {}).get(name)
+        if base is None:
+            rows.append([name, "-", "-", "-", "-", "-", "-", "no baseline"])
+            continue
+        population = sorted(entry["population"])
+        if base.get("steps") != entry["steps"] or base.get("final_population") != population:
+            # The benchmark no longer replays the same workload, so timings are not comparable
+            rows.append([name, "workload", "pop %s" % base.get("final_population"), "pop %s" % population,
+                         "-", "-", "-", "CHANGED"])
+            failed = True
+            continue
+        for metric, samples in sorted(entry["samples"].items()):
+            base_metric = base["metrics"].get(metric)
+            if base_metric is None:
+                continue
+            tolerance = metric_tolerance(baseline, base_metric, metric)
+            mean, ci = summarize(samples, confidence)
+            delta, noise, status = classify(base_metric["mean"], base_metric["ci"], mean, ci, tolerance)
+            failed = failed or status == "REGRESSION"
+            rows.append([name, metric, format_ns(base_metric["mean"]), format_ns(mean),
+                         "%+.1f%%" % (delta * 100), "%.1f%%" % (noise * 100), "%.0f%%" % (tolerance * 100), status])
+    print_table(rows)
+    return failed
+
+
+def write_baseline(path, previous, results, confidence, runs, invocations):
+    baseline = {
+        "schema": 1,
+        "confidence": confidence,
+        "runs": runs,
+        "invocations": invocations,
+        "default_tolerance": previous.get("default_tolerance", DEFAULT_TOLERANCE),
+        "metric_tolerances": previous.get("metric_tolerances", {}),
+        "scenarios": {},
+    }
+    for name, entry in sorted(results.items()):
+        old_metrics = previous.get("scenarios", {}).get(name, {}).get("metrics", {})
+        metrics = {}
+        for metric, samples in sorted(entry["samples"].items()):
+            mean, ci = summarize(samples, confidence)
+            metrics[metric] = {"mean": round(mean, 1), "ci": round(ci, 1), "n": len(samples)}
+            if "tolerance" in old_metrics.get(metric, {}):
+                metrics[metric]["tolerance"] = old_metrics[metric]["tolerance"]
+        baseline["scenarios"][name] = {
+            "steps": entry["steps"],
+            "seed": entry["seed"],
+            "final_population": sorted(entry["population"]),
+            "metrics": metrics,
+        }
+    with open(path, "w") as f:
+        json.dump(baseline, f, indent=2, sort_keys=True)
+        f.write("\n")
+    print("Wrote baseline for %d scenario(s) to %s" % (len(results), path))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--binary", required=True, help="simulator executable (headless builds work)")
+    parser.add_argument("--baseline", default=DEFAULT_BASELINE, help="baseline JSON (default: bench/baseline.json)")
+    parser.add_argument("--scenario", help="only run this scenario (workload:NAME for a captured workload)")
+    parser.add_argument("--workloads", default=DEFAULT_WORKLOADS,
+                        help="directory of captured workloads (*.alck) to replay (default: bench/workloads)")
+    parser.add_argument("--runs", type=int, default=5, help="timed runs per invocation (default: 5)")
+    parser.add_argument("--invocations", type=int, default=2,
+                        help="separate processes to start, to include process-level noise (default: 2)")
+    parser.add_argument("--seed", type=int, help="override the benchmark seed")
+    parser.add_argument("--confidence", type=float, choices=sorted(T_CRITICAL), default=0.95)
+    parser.add_argument("--update-baseline", action="store_true", help="record the results as the new baseline")
+    args = parser.parse_args()
+
+    if args.runs < 1 or args.invocations < 1 or args.runs * args.invocations < 2:
+        parser.error("need at least two samples per metric")
+
+    previous = {}
+    if os.path.exists(args.baseline):
+        with open(args.baseline) as f:
+            previous = json.load(f)
+    elif not args.update_baseline:
+        print("Baseline %s does not exist; run with --update-baseline first" % args.baseline, file=sys.stderr)
+        return 2
+
+    try:
+        commands = suite_commands(args.binary, args.scenario, args.runs, args.seed, args.workloads)
+        results = run_suite(commands, args.invocations)
+    except (OSError, subprocess.CalledProcessError) as e:
+        print("Benchmark failed: %s" % e, file=sys.stderr)
+        return 2
+
+    if args.update_baseline:
+        write_baseline(args.baseline, previous, results, args.confidence, args.runs, args.invocations)
+        return 0
+
+    if compare(previous, results, args.confidence):
+        print("\nPerformance regression detected.")
+        return 1
+    print("\nNo performance regression.")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
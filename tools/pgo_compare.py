@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""Release vs LTO vs PGO comparison for the artificial life simulator.
+
+Builds the headless frontend three ways (plain -O3 release, release with LTO,
+and release with LTO and a two-stage PGO build trained on the benchmark suite),
+runs the benchmark suite on each build with the invocations interleaved, and
+prints the mean step and phase times of each build and its gain over the plain
+release build. All builds must end every scenario with the same population;
+if they do not, the comparison is meaningless and the script fails.
+
+    tools/pgo_compare.py
+    tools/pgo_compare.py --build-root /tmp/alife-pgo --invocations 5 --json pgo.json
+
+Exit status: 0 = compared, 1 = builds disagree on a final population, 2 = build or benchmark error.
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+
+from perf_gate import DEFAULT_WORKLOADS, format_ns, run_suite, suite_commands, summarize
+
+SOURCE_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+METRICS = ["step_ns", "update_ns", "interact_ns", "reproduce_ns"]
+
+# Build name -> CMake options; every build is a Release build
+BUILDS = [
+    ("release", []),
+    ("lto", ["-DALIFE_LTO=ON"]),
+    ("pgo", ["-DALIFE_LTO=ON"]),  # Configured with ALIFE_PGO=GENERATE, trained, then ALIFE_PGO=USE
+]
+
+
+def cmake(*args):
+    subprocess.run(["cmake"] + list(args), check=True, stdout=subprocess.DEVNULL)
+
+
+def build(name, options, build_root):
+    """Configures and builds one variant; returns the path of its alife_headless."""
+    build_dir = os.path.join(build_root, name)
+    base = ["-S", SOURCE_DIR, "-B", build_dir, "-DCMAKE_BUILD_TYPE=Release"] + options
+    print("Building %s in %s" % (name, build_dir), file=sys.stderr)
+    if name == "pgo":
+        cmake(*(base + ["-DALIFE_PGO=GENERATE"]))
+        cmake("--build", build_dir, "--target", "alife_headless", "-j")
+        cmake("--build", build_dir, "--target", "pgo-train")
+        cmake(*(base + ["-DALIFE_PGO=USE"]))
+    else:
+        cmake(*(base + ["-DALIFE_PGO=OFF"]))
+    cmake("--build", build_dir, "--target", "alife_headless", "-j")
+    return os.path.join(build_dir, "alife_headless")
+
+
+def merge(into, results):
+    """Adds one run_suite result to the accumulated samples of a build."""
+    for scenario, entry in results.items():
+        target = into.setdefault(scenario, {"samples": {}, "population": set()})
+        for metric, values in entry["samples"].items():
+            target["samples"].setdefault(metric, []).extend(values)
+        target["population"].update(entry["population"])
+
+
+def print_table(scenarios, stats):
+    names = [name for name, _ in BUILDS]
+    header = "%-20s %-13s" % ("scenario", "metric") + "".join("  %-22s" % n for n in names)
+    print(header)
+    print("-" * len(header))
+    for scenario in scenarios:
+        for metric in METRICS:
+            base_mean = stats["release"][scenario][metric][0]
+            cells = []
+            for name in names:
+                mean, ci = stats[name][scenario][metric]
+                gain = "" if name == "release" else " %+6.1f%%" % ((base_mean / mean - 1.0) * 100.0)
+                cells.append("%-22s" % ("%s +/-%.1f%%%s" % (format_ns(mean), ci / mean * 100.0, gain)))
+            print("%-20s %-13s  %s" % (scenario, metric, "  ".join(cells)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--build-root", default=os.path.join(SOURCE_DIR, "build-pgo-compare"),
+                        help="directory holding one build directory per variant (default: build-pgo-compare)")
+    parser.add_argument("--skip-build", action="store_true", help="reuse the binaries of an earlier run")
+    parser.add_argument("--workloads", default=DEFAULT_WORKLOADS,
+                        help="directory of captured workloads (*.alck) to replay (default: bench/workloads)")
+    parser.add_argument("--runs", type=int, default=5, help="timed runs per invocation (default: 5)")
+    parser.add_argument("--invocations", type=int, default=3,
+                        help="processes started per build, interleaved across builds (default: 3)")
+    parser.add_argument("--json", help="also write the results to this JSON file")
+    args = parser.parse_args()
+
+    if args.runs < 1 or args.invocations < 1 or args.runs * args.invocations < 2:
+        parser.error("need at least two samples per metric")
+
+    try:
+        binaries = {}
+        for name, options in BUILDS:
+            binaries[name] = (os.path.join(args.build_root, name, "alife_headless") if args.skip_build
+                              else build(name, options, args.build_root))
+        # Interleaving the builds spreads slow drifts of the machine (thermal, other load) evenly
+        samples = {name: {} for name in binaries}
+        for _ in range(args.invocations):
+            for name, binary in binaries.items():
+                commands = suite_commands(binary, None, args.runs, None, args.workloads)
+                merge(samples[name], run_suite(commands, 1))
+    except (OSError, subprocess.CalledProcessError) as e:
+        print("Build or benchmark failed: %s" % e, file=sys.stderr)
+        return 2
+
+    scenarios = list(samples["release"])
+    mismatched = [s for s in scenarios
+                  if any(samples[name].get(s, {}).get("population") != samples["release"][s]["population"]
+                         for name in binaries)]
+    if mismatched:
+        for s in mismatched:
+            print("Final population of %s differs between builds: %s" % (
+                s, ", ".join("%s %s" % (n, sorted(samples[n].get(s, {}).get("population", [])))
+                             for n in binaries)), file=sys.stderr)
+        return 1
+
+    stats = {name: {s: {m: summarize(samples[name][s]["samples"][m], 0.95) for m in METRICS}
+                    for s in scenarios} for name in binaries}
+    print_table(scenarios, stats)
+
+    if args.json:
+        report = {name: {s: {m: {"mean": mean, "ci": ci} for m, (mean, ci) in metrics.items()}
+                         for s, metrics in per_scenario.items()} for name, per_scenario in stats.items()}
+        with open(args.json, "w") as f:
+            json.dump(report, f, indent=2)
+            f.write("\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
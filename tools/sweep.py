@@ -0,0 +1,204 @@
+#!/usr/bin/env python3
+"""Parallel parameter sweep for the artificial life simulator.
+
+Reads a sweep specification (JSON), runs the simulator headless (--run --json)
+once for every combination of parameter values and every seed, spread over the
+local cores, and writes a consolidated results table. Every completed run is
+stored in its own file under the output directory, so an interrupted sweep
+resumes where it stopped: runs whose result is on disk are not run again.
+
+    tools/sweep.py bench/sweeps/ecology.json --binary ./alife_headless --out sweep-ecology
+    tools/sweep.py bench/sweeps/ecology.json --binary ./alife_headless --out sweep-ecology --jobs 4
+
+The specification is a JSON object. "parameters" maps run options, named
+without their leading "--", to the values to sweep; any option of --run can be
+swept, the ecology options being the usual ones. "seeds" is a count (seeds
+1..N) or a list. The other keys and their defaults: "scenario" ("default"),
+"steps" per run (10000), "stop_extinct" (true), "stop_steady" window in steps
+(0 = never), "steady_tolerance" (0.05) and "options" passed to every run ([]).
+
+    {"steps": 20000, "seeds": 8, "stop_steady": 2000,
+     "parameters": {"energy-loss": [0.03, 0.05], "reproduction-threshold": [60, 80, 100]}}
+
+Output: results.csv (one row per run) and summary.csv (one row per parameter
+combination, aggregated over its seeds), also printed as a table.
+
+Exit status: 0 = every run completed, 1 = a run failed, 2 = invalid specification.
+"""
+
+import argparse
+import concurrent.futures
+import csv
+import hashlib
+import itertools
+import json
+import os
+import subprocess
+import sys
+
+RESULT_FIELDS = ["steps", "stop", "final_population", "final_food", "peak_population", "mean_population",
+                 "births", "deaths", "feeds", "extinct_step"]
+
+
+def load_spec(path):
+    """Reads and checks a sweep specification; returns it with defaults filled in."""
+    with open(path) as f:
+        spec = json.load(f)
+    spec.setdefault("scenario", "default")
+    spec.setdefault("steps", 10000)
+    spec.setdefault("seeds", 1)
+    spec.setdefault("stop_extinct", True)
+    spec.setdefault("stop_steady", 0)
+    spec.setdefault("steady_tolerance", 0.05)
+    spec.setdefault("options", [])
+    spec.setdefault("parameters", {})
+    if isinstance(spec["seeds"], int):
+        spec["seeds"] = list(range(1, spec["seeds"] + 1))
+    if not spec["seeds"] or not all(isinstance(v, list) and v for v in spec["parameters"].values()):
+        raise ValueError("seeds and every parameter need at least one value")
+    return spec
+
+
+def plan_runs(spec, binary):
+    """Every run of the sweep as (parameter values, seed, command), in table order."""
+    names = sorted(spec["parameters"])
+    base = [binary, "--run", "--json", "--scenario", spec["scenario"], "--steps", str(spec["steps"])]
+    if spec["stop_extinct"]:
+        base.append("--stop-extinct")
+    if spec["stop_steady"]:
+        base += ["--stop-steady", str(spec["stop_steady"]), "--steady-tolerance", str(spec["steady_tolerance"])]
+    runs = []
+    for values in itertools.product(*(spec["parameters"][name] for name in names)):
+        params = dict(zip(names, values))
+        for seed in spec["seeds"]:
+            cmd = base + ["--seed", str(seed)] + list(spec["options"])
+            for name in names:
+                cmd += ["--" + name, str(params[name])]
+            runs.append((params, seed, cmd))
+    return names, runs
+
+
+def result_path(out_dir, cmd):
+    """Result file of a run, named by its command line (without the binary) so that a changed
+    specification never reuses the results of a different run."""
+    key = hashlib.sha1(" ".join(cmd[1:]).encode()).hexdigest()[:16]
+    return os.path.join(out_dir, "runs", key + ".json")
+
+
+def load_result(path, cmd):
+    """Returns the stored result of a run, or None if it has not completed."""
+    try:
+        with open(path) as f:
+            stored = json.load(f)
+    except (OSError, ValueError):
+        return None
+    return stored["result"] if stored.get("command") == cmd[1:] else None
+
+
+def execute(cmd, path):
+    """Runs one simulation and stores its result; returns the result, or None on failure."""
+    proc = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True)
+    lines = [line for line in proc.stdout.splitlines() if line.startswith("{")]
+    if proc.returncode != 0 or not lines:
+        sys.stderr.write("Run failed (%d): %s\n%s" % (proc.returncode, " ".join(cmd), proc.stderr))
+        return None
+    result = json.loads(lines[-1])
+    # Written to a temporary file first: an interrupted write must not look like a completed run
+    with open(path + ".tmp", "w") as f:
+        json.dump({"command": cmd[1:], "result": result}, f)
+    os.replace(path + ".tmp", path)
+    return result
+
+
+def mean(values):
+    return sum(values) / len(values) if values else float("nan")
+
+
+def write_tables(out_dir, names, runs, results):
+    """Writes results.csv and summary.csv; returns the header and rows of the summary."""
+    with open(os.path.join(out_dir, "results.csv"), "w", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow(names + ["seed"] + RESULT_FIELDS)
+        for (params, seed, _), result in zip(runs, results):
+            if result is not None:
+                writer.writerow([params[n] for n in names] + [seed] + [result[k] for k in RESULT_FIELDS])
+
+    summary = []
+    for key, group in itertools.groupby(zip(runs, results), lambda item: tuple(item[0][0][n] for n in names)):
+        done = [result for _, result in group if result is not None]
+        summary.append(list(key) + [
+            len(done),
+            sum(r["stop"] == "extinct" for r in done) / len(done) if done else float("nan"),
+            sum(r["stop"] == "steady" for r in done) / len(done) if done else float("nan"),
+            mean([r["final_population"] for r in done]),
+            mean([r["peak_population"] for r in done]),
+            mean([r["mean_population"] for r in done]),
+            mean([r["steps"] for r in done]),
+        ])
+    header = names + ["runs", "extinct", "steady", "final_population", "peak_population", "mean_population",
+                      "steps"]
+    with open(os.path.join(out_dir, "summary.csv"), "w", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow(header)
+        writer.writerows(summary)
+    return header, summary
+
+
+def print_summary(header, summary):
+    widths = [max(len(h), 8) for h in header]
+    print("  ".join("%-*s" % (w, h) for w, h in zip(widths, header)))
+    print("-" * (sum(widths) + 2 * (len(widths) - 1)))
+    for row in summary:
+        cells = [("%.2f" % v) if isinstance(v, float) else str(v) for v in row]
+        print("  ".join("%-*s" % (w, c) for w, c in zip(widths, cells)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("spec", help="sweep specification (JSON)")
+    parser.add_argument("--binary", required=True, help="simulator executable (headless builds work)")
+    parser.add_argument("--out", required=True, help="output directory; holds the results of completed runs")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count() or 1,
+                        help="runs executed at once, one thread each (default: number of CPUs)")
+    args = parser.parse_args()
+
+    try:
+        spec = load_spec(args.spec)
+    except (OSError, ValueError, TypeError) as e:
+        print("Invalid sweep specification %s: %s" % (args.spec, e), file=sys.stderr)
+        return 2
+    if args.jobs < 1:
+        parser.error("--jobs must be at least 1")
+
+    names, runs = plan_runs(spec, os.path.abspath(args.binary))
+    os.makedirs(os.path.join(args.out, "runs"), exist_ok=True)
+    paths = [result_path(args.out, cmd) for _, _, cmd in runs]
+    results = [load_result(path, cmd) for path, (_, _, cmd) in zip(paths, runs)]
+    pending = [i for i, result in enumerate(results) if result is None]
+    print("%d runs, %d already completed, %d to run on %d jobs" % (
+        len(runs), len(runs) - len(pending), len(pending), args.jobs), file=sys.stderr)
+
+    failed = 0
+    # Each run is its own process; the threads only wait for them
+    with concurrent.futures.ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        futures = {pool.submit(execute, runs[i][2], paths[i]): i for i in pending}
+        for done, future in enumerate(concurrent.futures.as_completed(futures), 1):
+            i = futures[future]
+            results[i] = future.result()
+            params, seed, _ = runs[i]
+            label = " ".join("%s=%s" % (n, params[n]) for n in names)
+            if results[i] is None:
+                failed += 1
+                status = "failed"
+            else:
+                status = "%s after %d steps, population %d" % (
+                    results[i]["stop"], results[i]["steps"], results[i]["final_population"])
+            print("[%d/%d] %s seed %s: %s" % (done, len(pending), label, seed, status), file=sys.stderr)
+
+    header, summary = write_tables(args.out, names, runs, results)
+    print_summary(header, summary)
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
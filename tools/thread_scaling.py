@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""Thread scaling study for the artificial life simulator.
+
+Runs one benchmark scenario at thread counts 1..N (optionally for several
+pinning strategies), reports speedup and parallel efficiency for the whole
+step and for each phase, and flags the phases that stop scaling, which are
+the serial bottlenecks.
+
+The update phase only runs on the worker pool while food exists (global sensing), and
+every benchmark scenario eats its food: `large` has none left after about 50 steps. By
+default every run therefore adds --food-respawn 1, which keeps the food count constant,
+so the parallel path runs on every measured step. Pass --world-options "" to measure the
+scenario as it is.
+
+    tools/thread_scaling.py --binary ./alife_headless --scenario large --max-threads 8
+    tools/thread_scaling.py --binary ./alife_headless --pin none,compact,scatter --json scaling.json
+"""
+
+import argparse
+import json
+import os
+import shlex
+import subprocess
+import sys
+
+from perf_gate import format_ns, summarize
+
+METRICS = ["step_ns", "update_ns", "interact_ns", "reproduce_ns"]
+DEFAULT_WORLD_OPTIONS = "--food-respawn 1"  # Food never runs out, so the update phase stays parallel
+
+
+def measure(binary, scenario, threads, pin, runs, steps, world_options):
+    """Runs the scenario once per configuration; returns {metric: (mean, ci)} and the final populations."""
+    cmd = [binary, "--bench", "--scenario", scenario, "--runs", str(runs),
+           "--threads", str(threads), "--pin", pin] + world_options
+    if steps:
+        cmd += ["--steps", str(steps)]
+    out = subprocess.run(cmd, check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout
+    record = json.loads(next(line for line in out.splitlines() if line.startswith("{")))
+    stats = {metric: summarize(record["metrics"][metric], 0.95) for metric in METRICS}
+    return stats, sorted(set(record["final_population"]))
+
+
+def study(args, pin):
+    """Measures every thread count for one pinning strategy; returns a list of per-thread-count rows."""
+    rows = []
+    populations = None
+    for threads in range(1, args.max_threads + 1):
+        stats, population = measure(args.binary, args.scenario, threads, pin, args.runs, args.steps,
+                                     shlex.split(args.world_options))
+        if populations is None:
+            populations = population
+        elif population != populations:
+            print("warning: final population differs at %d threads (%s vs %s); the parallel path is not "
+                  "deterministic" % (threads, population, populations), file=sys.stderr)
+        row = {"threads": threads, "pin": pin, "metrics": {}}
+        for metric in METRICS:
+            mean, ci = stats[metric]
+            base = rows[0]["metrics"][metric]["mean"] if rows else mean
+            speedup = base / mean if mean > 0 else 0.0
+            row["metrics"][metric] = {"mean": mean, "ci": ci, "speedup": speedup, "efficiency": speedup / threads}
+        rows.append(row)
+    return rows
+
+
+def bottlenecks(rows, min_gain, min_efficiency):
+    """For each metric, the thread count after which adding threads stopped helping (None if it kept scaling)."""
+    flagged = {}
+    for metric in METRICS:
+        for prev, row in zip(rows, rows[1:]):
+            gain = row["metrics"][metric]["speedup"] / max(prev["metrics"][metric]["speedup"], 1e-9)
+            if gain < 1.0 + min_gain or row["metrics"][metric]["efficiency"] < min_efficiency:
+                flagged[metric] = prev["threads"]
+                break
+    return flagged
+
+
+def print_table(pin, rows, flagged):
+    print("\nPinning: %s" % pin)
+    header = "threads" + "".join("  %-28s" % m for m in METRICS)
+    print(header)
+    print("-" * len(header))
+    for row in rows:
+        cells = []
+        for metric in METRICS:
+            m = row["metrics"][metric]
+            cells.append("%-28s" % ("%s %5.2fx %4.0f%%" % (format_ns(m["mean"]), m["speedup"], m["efficiency"] * 100)))
+        print("%7d  %s" % (row["threads"], "  ".join(cells)))
+    for metric in METRICS:
+        last = rows[-1]["metrics"][metric]
+        if metric in flagged:
+            print("  %-13s stops scaling after %d thread(s) (%.2fx at %d threads)"
+                  % (metric, flagged[metric], last["speedup"], rows[-1]["threads"]))
+        else:
+            print("  %-13s scales (%.2fx at %d threads)" % (metric, last["speedup"], rows[-1]["threads"]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--binary", required=True, help="simulator executable (headless builds work)")
+    parser.add_argument("--scenario", default="large", help="benchmark scenario (default: large)")
+    parser.add_argument("--max-threads", type=int, default=os.cpu_count() or 1,
+                        help="largest thread count to try (default: number of CPUs)")
+    parser.add_argument("--pin", default="none", help="comma-separated pinning strategies: none, compact, scatter")
+    parser.add_argument("--runs", type=int, default=5, help="timed runs per configuration (default: 5)")
+    parser.add_argument("--steps", type=int, help="override the scenario's step count")
+    parser.add_argument("--world-options", default=DEFAULT_WORLD_OPTIONS,
+                        help="world options added to every run (default: %r, which keeps food present so "
+                             "the update phase runs in parallel on every step)" % DEFAULT_WORLD_OPTIONS)
+    parser.add_argument("--min-gain", type=float, default=0.10,
+                        help="a phase stops scaling when one more thread speeds it up by less than this (default: 0.10)")
+    parser.add_argument("--min-efficiency", type=float, default=0.50,
+                        help="...or when its parallel efficiency drops below this (default: 0.50)")
+    parser.add_argument("--json", help="also write the results to this JSON file")
+    args = parser.parse_args()
+
+    if args.max_threads < 1 or args.runs < 2:
+        parser.error("need --max-threads >= 1 and --runs >= 2")
+
+    report = {"scenario": args.scenario, "world_options": args.world_options, "studies": []}
+    for pin in args.pin.split(","):
+        try:
+            rows = study(args, pin)
+        except (OSError, subprocess.CalledProcessError) as e:
+            print("Benchmark failed: %s" % e, file=sys.stderr)
+            return 2
+        flagged = bottlenecks(rows, args.min_gain, args.min_efficiency)
+        print_table(pin, rows, flagged)
+        report["studies"].append({"pin": pin, "rows": rows, "stops_scaling_after": flagged})
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(report, f, indent=2)
+            f.write("\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())